@@ -5,97 +5,482 @@
  *      Author: Timor
  */
 
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 #include "ILP_solver.h"
+#include "search.h"
+#include "arena.h"
 
 #define DEFAULT 0
-#define MALLOC_ERROR "Error: malloc has failed.\n"
-#define CALLOC_ERROR "Error: calloc has failed.\n"
+#define LOG_FILE "sudoku.log"
+
+/*
+ * Structure: Variables
+ * ------------------
+ * 	A structure used to map the model's variables to the board. Every option of every empty cell
+ * 	is a variable, the variables of a cell are consecutive and ordered by value, so the map takes
+ * 	memory by the amount of cells and options and not by board_size^3.
+ *
+ * 	cell_first : for every cell, the index of its first variable (cells_count + 1 entries).
+ * 	var_value : for every variable, the value it stands for.
+ * 	count : the amount of variables.
+ */
+typedef struct {
+	int* cell_first;
+	int* var_value;
+	int count;
+} Variables;
+
+/*
+ * Structure: Workspace
+ * ------------------
+ * 	The long lived state of the solver, created on the first solve and kept until ilp_teardown: the
+ * 	Gurobi environment, and scratch buffers that only grow, so a solve no bigger than the ones before
+ * 	it allocates nothing but its model.
+ *
+ * 	env : the Gurobi environment, NULL before the first solve.
+ * 	vars : the variables map of the current solve.
+ * 	cells_capacity : the amount of cells vars.cell_first has room for.
+ * 	vars_capacity : the amount of variables vars.var_value, sol, var_obj and vtype have room for.
+ * 	sol : the values of the variables in the solution.
+ * 	var_obj : the objective coefficients of the variables.
+ * 	vtype : the types of the variables.
+ * 	rows, nnz : the amount of constraints and entries of the current model.
+ * 	rows_capacity : the amount of constraints beg, sense and rhs have room for.
+ * 	beg, sense, rhs : the first entry, the sense and the right hand side of every constraint.
+ * 	nnz_capacity : the amount of entries cind and cval have room for, at least board_size.
+ * 	cind, cval : the variables and coefficients of the constraints, one after the other.
+ * 	value_next : for every value, where its next variable goes in cind while a unit is assembled
+ * 			(board_size + 1 entries, cells_capacity has room for them).
+ */
+typedef struct {
+	GRBenv* env;
+	Variables vars;
+	int cells_capacity;
+	int vars_capacity;
+	double* sol;
+	double* var_obj;
+	char* vtype;
+	int rows;
+	int nnz;
+	int rows_capacity;
+	int* beg;
+	char* sense;
+	double* rhs;
+	int nnz_capacity;
+	int* cind;
+	double* cval;
+	int* value_next;
+} Workspace;
+
+Workspace workspace;
+
+/*
+ * Structure: LiveModel
+ * ------------------
+ * 	The ILP model of the session, kept between calls of ilp. It is built for a position (its base),
+ * 	and later positions that only fill or clear cells that were empty in the base are solved by
+ * 	fixing and freeing the variables of those cells, instead of building a new model.
+ *
+ * 	model : the Gurobi model, NULL if there is none.
+ * 	board_size, block_row : the shape of the base.
+ * 	vars : the variables map of the model.
+ * 	cells_capacity, vars_capacity : the amount of cells and variables vars has room for.
+ * 	base : the values of the cells of the base.
+ * 	applied : for every cell empty in the base, the value its variables are fixed to, 0 if they
+ * 			are free.
+ */
+typedef struct {
+	GRBmodel* model;
+	int board_size;
+	int block_row;
+	Variables vars;
+	int cells_capacity;
+	int vars_capacity;
+	unsigned char* base;
+	unsigned char* applied;
+} LiveModel;
+
+LiveModel live;
+
+int ilp_debug = 0;
+long ilp_models = 0;
+long ilp_reuses = 0;
+long ilp_presolve_solved = 0;
+long ilp_presolve_unsolvable = 0;
+long ilp_presolve_eliminated = 0;
+double ilp_build_seconds = 0;
+double ilp_solve_seconds = 0;
+
+/*
+ * Function: wall_seconds
+ * ----------------------
+ * 	Returns the seconds of a monotonic wall clock. Gurobi solves on several threads, so the
+ * 	processor time of the program would count a solve several times over.
+ */
+double wall_seconds() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * Function: reserve_workspace
+ * ----------------------
+ * 	Makes room in the workspace buffers for a board of board_size with count variables.
+ */
+void reserve_workspace(int board_size, int count) {
+	int i, cells_count = board_size * board_size;
+	/* a constraint per empty cell and per unit and value, every variable is in four of them */
+	int rows_count = 4 * cells_count, nnz = 4 * count > board_size ? 4 * count : board_size;
+
+	if (cells_count + 1 > workspace.cells_capacity) {
+		workspace.cells_capacity = cells_count + 1;
+		workspace.vars.cell_first = (int*) safe_realloc(workspace.vars.cell_first,
+				sizeof(int) * workspace.cells_capacity);
+		workspace.value_next = (int*) safe_realloc(workspace.value_next,
+				sizeof(int) * workspace.cells_capacity);
+	}
+	if (count + 1 > workspace.vars_capacity) {
+		workspace.vars_capacity = count + 1 > 2 * workspace.vars_capacity ?
+				count + 1 : 2 * workspace.vars_capacity;
+		workspace.vars.var_value = (int*) safe_realloc(workspace.vars.var_value,
+				sizeof(int) * workspace.vars_capacity);
+		workspace.sol = (double*) safe_realloc(workspace.sol,
+				sizeof(double) * workspace.vars_capacity);
+		workspace.var_obj = (double*) safe_realloc(workspace.var_obj,
+				sizeof(double) * workspace.vars_capacity);
+		workspace.vtype = (char*) safe_realloc(workspace.vtype,
+				sizeof(char) * workspace.vars_capacity);
+	}
+	if (rows_count > workspace.rows_capacity) {
+		workspace.rows_capacity = rows_count;
+		workspace.beg = (int*) safe_realloc(workspace.beg,
+				sizeof(int) * workspace.rows_capacity);
+		workspace.sense = (char*) safe_realloc(workspace.sense,
+				sizeof(char) * workspace.rows_capacity);
+		workspace.rhs = (double*) safe_realloc(workspace.rhs,
+				sizeof(double) * workspace.rows_capacity);
+		for (i = 0; i < workspace.rows_capacity; i++) {
+			workspace.sense[i] = GRB_EQUAL;
+			workspace.rhs[i] = 1.0;
+		}
+	}
+	if (nnz > workspace.nnz_capacity) {
+		workspace.nnz_capacity = nnz > 2 * workspace.nnz_capacity ?
+				nnz : 2 * workspace.nnz_capacity;
+		workspace.cind = (int*) safe_realloc(workspace.cind,
+				sizeof(int) * workspace.nnz_capacity);
+		workspace.cval = (double*) safe_realloc(workspace.cval,
+				sizeof(double) * workspace.nnz_capacity);
+		for (i = 0; i < workspace.nnz_capacity; i++)
+			workspace.cval[i] = 1.0;
+	}
+}
 
 /*
- * Function: create_environment
+ * Function: build_variables
  * ----------------------
- * 	Receives pointers to environment and model and creates the proper Gurobi items according to the type
+ * 	Receives a board and fills the variables map of the workspace with the options of its empty cells,
+ * 	making room for them in the workspace.
  *
+ * 	returns: 1 on success, 0 if an empty cell has no options (the board is unsolvable).
  */
-int create_environment(GRBenv **env, GRBmodel **model, int type) {
-	int e = 0;
+int build_variables(Board* game, Variables* vars) {
+	int i, value, cells_count = game->board_size * game->board_size;
+	OptionsSet* options;
+
+	vars->count = 0;
+	for (i = 0; i < cells_count; i++)
+		if (game->cells[i].value == DEFAULT) {
+			if (game->cells[i].options.length == 0)
+				return 0;
+			vars->count += game->cells[i].options.length;
+		}
+	reserve_workspace(game->board_size, vars->count);
+
+	vars->count = 0;
+	for (i = 0; i < cells_count; i++) {
+		vars->cell_first[i] = vars->count;
+		if (game->cells[i].value == DEFAULT) {
+			options = &game->cells[i].options;
+			for (value = options_next(options, 0); value;
+					value = options_next(options, value))
+				vars->var_value[vars->count++] = value;
+		}
+	}
+	vars->cell_first[cells_count] = vars->count;
+	return 1;
+}
 
-	if (type == 0)
-		e = GRBloadenv(env, "integerLinearProgram.log");
-	else
-		e = GRBloadenv(env, "linearProgram.log");
+/*
+ * Function: variable_index
+ * ----------------------
+ * 	Returns the index of the variable of the given cell and value, or -1 if there is none.
+ */
+int variable_index(Variables* vars, int cell, int value) {
+	int i;
+
+	for (i = vars->cell_first[cell]; i < vars->cell_first[cell + 1]; i++)
+		if (vars->var_value[i] == value)
+			return i;
+	return -1;
+}
+
+/*
+ * Function: set_log_file
+ * ----------------------
+ * 	Points the log of the environment to LOG_FILE in debug mode, and turns it off otherwise.
+ *
+ * 	returns: 1 on success, 0 otherwise.
+ */
+int set_log_file() {
+	int e = GRBsetstrparam(workspace.env, GRB_STR_PAR_LOGFILE,
+			ilp_debug ? LOG_FILE : "");
 	if (e) {
-		printf("ERROR %d GRBloadenv(): %s\n", e, GRBgeterrormsg(*env));
+		printf("ERROR %d GRBsetstrparam(): %s\n", e,
+				GRBgeterrormsg(workspace.env));
 		return 0;
 	}
+	return 1;
+}
 
-	e = GRBsetintparam(*env, GRB_INT_PAR_LOGTOCONSOLE, 0);
-	if (e) {
-		printf("ERROR %d GRBsetintparam(): %s\n", e, GRBgeterrormsg(*env));
-		return 0;
+/*
+ * Function: create_model
+ * ----------------------
+ * 	Creates a new empty model in the environment of the workspace, loading the environment
+ * 	on first use.
+ *
+ * 	returns: 1 on success, 0 otherwise.
+ */
+int create_model(GRBmodel **model) {
+	int e = 0;
+
+	if (!workspace.env) {
+		e = GRBloadenv(&workspace.env, NULL);
+		if (e) {
+			printf("ERROR %d GRBloadenv(): %s\n", e,
+					GRBgeterrormsg(workspace.env));
+			workspace.env = NULL;
+			return 0;
+		}
+
+		e = GRBsetintparam(workspace.env, GRB_INT_PAR_LOGTOCONSOLE, 0);
+		if (e) {
+			printf("ERROR %d GRBsetintparam(): %s\n", e,
+					GRBgeterrormsg(workspace.env));
+			return 0;
+		}
+		if (ilp_debug && !set_log_file())
+			return 0;
 	}
 
-	e = GRBnewmodel(*env, model, "linearProgram", 0, NULL, NULL, NULL, NULL,
-	NULL);
+	e = GRBnewmodel(workspace.env, model, "linearProgram", 0, NULL, NULL, NULL,
+			NULL, NULL);
 	if (e) {
-		printf("ERROR %d GRBnewmodel(): %s\n", e, GRBgeterrormsg(*env));
+		printf("ERROR %d GRBnewmodel(): %s\n", e, GRBgeterrormsg(workspace.env));
 		return 0;
 	}
 
 	return 1;
 }
 
+void ilp_set_debug(int debug) {
+	ilp_debug = debug;
+	if (workspace.env)
+		set_log_file();
+}
+
 /*
- * Function: free_all
- * ----------------------
- * 	Receives pointers to all allocated memory variables and frees them
+ * Structure: Dump
+ * ------------------
+ * 	A copy of a model, written to an .lp file by a thread of its own so the command that built the
+ * 	model doesn't wait for the disk.
  *
+ * 	path : the file to write.
+ * 	board_size, count, rows, nnz : the board size, and the amount of variables, constraints and
+ * 			entries of the model.
+ * 	var_cell, var_value : the cell and the value of every variable.
+ * 	obj, vtype : the objective coefficient and the type of every variable.
+ * 	beg, cind : the constraints, as in the workspace.
  */
-void free_all(GRBenv* env, GRBmodel* model, double* sol, int* ind, double* obj,
-		char* vtype, int* indexes) {
-	free(sol);
-	free(obj);
-	free(ind);
-	free(vtype);
-	free(indexes);
-	GRBfreemodel(model);
-	GRBfreeenv(env);
+typedef struct {
+	const char* path;
+	int board_size;
+	int count;
+	int rows;
+	int nnz;
+	int* var_cell;
+	int* var_value;
+	double* obj;
+	char* vtype;
+	int* beg;
+	int* cind;
+} Dump;
+
+pthread_t dump_thread;
+int dump_running = 0;
+
+/*
+ * Function: write_variable
+ * ----------------------
+ * 	Writes the name of a variable of the dump, x<row>_<column>_<value>.
+ */
+void write_variable(FILE* file, Dump* dump, int var) {
+	fprintf(file, " x%d_%d_%d", dump->var_cell[var] / dump->board_size + 1,
+			dump->var_cell[var] % dump->board_size + 1, dump->var_value[var]);
+}
+
+/*
+ * Function: write_dump
+ * ----------------------
+ * 	The thread routine of a dump: writes it in LP format and frees it.
+ */
+void* write_dump(void* arg) {
+	Dump* dump = (Dump*) arg;
+	int i, k, end;
+	FILE* file = fopen(dump->path, "w");
+
+	if (file) {
+		fprintf(file, "Maximize\n obj:");
+		for (i = 0; i < dump->count; i++) {
+			fprintf(file, "%s %.6g", i ? (i % 8 ? " +" : "\n +") : "", dump->obj[i]);
+			write_variable(file, dump, i);
+		}
+		fprintf(file, "\nSubject To\n");
+		for (i = 0; i < dump->rows; i++) {
+			end = i + 1 < dump->rows ? dump->beg[i + 1] : dump->nnz;
+			fprintf(file, " R%d:", i);
+			for (k = dump->beg[i]; k < end; k++) {
+				if (k > dump->beg[i])
+					fprintf(file, (k - dump->beg[i]) % 8 ? " +" : "\n +");
+				write_variable(file, dump, dump->cind[k]);
+			}
+			fprintf(file, " = 1\n");
+		}
+		fprintf(file, "Binaries\n");
+		for (i = 0; i < dump->count; i++)
+			if (dump->vtype[i] == GRB_BINARY)
+				write_variable(file, dump, i);
+		fprintf(file, "\nEnd\n");
+		fclose(file);
+	}
+
+	free(dump->var_cell);
+	free(dump->var_value);
+	free(dump->obj);
+	free(dump->vtype);
+	free(dump->beg);
+	free(dump->cind);
+	free(dump);
+	return NULL;
+}
+
+/*
+ * Function: finish_dump
+ * ----------------------
+ * 	Waits for the dump being written, if there is one.
+ */
+void finish_dump() {
+	if (dump_running) {
+		pthread_join(dump_thread, NULL);
+		dump_running = 0;
+	}
+}
+
+/*
+ * Function: dump_model
+ * ----------------------
+ * 	Copies the model of the workspace and starts writing it to path in the background. One dump is
+ * 	written at a time, a dump waits for the one before it.
+ */
+void dump_model(const char* path, int board_size) {
+	int i, k;
+	Variables* vars = &workspace.vars;
+	Dump* dump = (Dump*) safe_malloc(sizeof(Dump));
+
+	dump->path = path;
+	dump->board_size = board_size;
+	dump->count = vars->count;
+	dump->rows = workspace.rows;
+	dump->nnz = workspace.nnz;
+	dump->var_cell = (int*) safe_malloc(sizeof(int) * (vars->count + 1));
+	dump->var_value = (int*) safe_malloc(sizeof(int) * (vars->count + 1));
+	dump->obj = (double*) safe_malloc(sizeof(double) * (vars->count + 1));
+	dump->vtype = (char*) safe_malloc(sizeof(char) * (vars->count + 1));
+	dump->beg = (int*) safe_malloc(sizeof(int) * (workspace.rows + 1));
+	dump->cind = (int*) safe_malloc(sizeof(int) * (workspace.nnz + 1));
+
+	for (i = 0; i < board_size * board_size; i++)
+		for (k = vars->cell_first[i]; k < vars->cell_first[i + 1]; k++)
+			dump->var_cell[k] = i;
+	memcpy(dump->var_value, vars->var_value, sizeof(int) * vars->count);
+	memcpy(dump->obj, workspace.var_obj, sizeof(double) * vars->count);
+	memcpy(dump->vtype, workspace.vtype, sizeof(char) * vars->count);
+	memcpy(dump->beg, workspace.beg, sizeof(int) * workspace.rows);
+	memcpy(dump->cind, workspace.cind, sizeof(int) * workspace.nnz);
+
+	finish_dump();
+	if (pthread_create(&dump_thread, NULL, write_dump, dump))
+		write_dump(dump);
+	else
+		dump_running = 1;
+}
+
+void ilp_teardown() {
+	finish_dump();
+	if (live.model)
+		GRBfreemodel(live.model);
+	free(live.vars.cell_first);
+	free(live.vars.var_value);
+	free(live.base);
+	free(live.applied);
+	memset(&live, 0, sizeof(live));
+	if (workspace.env)
+		GRBfreeenv(workspace.env);
+	free(workspace.vars.cell_first);
+	free(workspace.vars.var_value);
+	free(workspace.sol);
+	free(workspace.var_obj);
+	free(workspace.vtype);
+	free(workspace.beg);
+	free(workspace.sense);
+	free(workspace.rhs);
+	free(workspace.cind);
+	free(workspace.cval);
+	free(workspace.value_next);
+	memset(&workspace, 0, sizeof(workspace));
 }
 
 /*
  * Function: add_variables
  * ----------------------
- * 	Receives environment, model, types array, indexes array, and relevant info regarding
- * 	the environment variables and add the variables to the Gurobi model according to the current
- * 	run (ILP/LP).
+ * 	Receives model, variables map, and relevant info regarding the environment variables and add
+ * 	the variables to the Gurobi model according to the current run (ILP/LP), using the types and
+ * 	objective buffers of the workspace.
  *
  */
-int add_variables(GRBenv **env, GRBmodel **model, char** vtype, int count,
-		int type, int* indexes, int board_size) {
+int add_variables(GRBmodel **model, int count, int type, Variables* vars,
+		int board_size) {
 	int i, j = 0, k, e = 0, c, tmp, x;
-	double* obj = (double*) malloc(sizeof(double) * count);
-	if (!obj) {
-		printf("%s", MALLOC_ERROR);
-		exit(0);
-	}
+	double* obj = workspace.var_obj;
+	char* vtype = workspace.vtype;
 
 	if (type == 0)
 		for (i = 0; i < count; i++) {
-			(*vtype)[i] = GRB_BINARY;
+			vtype[i] = GRB_BINARY;
 			obj[i] = 1;
 		}
 	if (type == 1) {
-		for (i = 0; i < board_size * board_size * board_size; i += board_size) {
-			c = 0;
+		for (i = 0; i < board_size * board_size; i++) {
+			c = vars->cell_first[i + 1] - vars->cell_first[i];
 			tmp = 1;
-			for (k = i; k < i + board_size; k++) {
-				if (indexes[k] > 0) {
-					c += 1;
-				}
-			}
 			if (c != 0) {
 				if (c >= 9 && c != board_size)
 					x = (rand() % 4) * 2 - 1;
@@ -109,7 +494,7 @@ int add_variables(GRBenv **env, GRBmodel **model, char** vtype, int count,
 				}
 				x = board_size - c;
 				for (k = j; k < j + c; k++) {
-					(*vtype)[k] = GRB_CONTINUOUS;
+					vtype[k] = GRB_CONTINUOUS;
 					obj[k] = (double) ((rand() % 7) + 1) / c * tmp;
 				}
 				j += c;
@@ -117,152 +502,85 @@ int add_variables(GRBenv **env, GRBmodel **model, char** vtype, int count,
 		}
 	}
 
-	e = GRBaddvars(*model, count, 0, NULL, NULL, NULL, obj, NULL, NULL, *vtype,
+	e = GRBaddvars(*model, count, 0, NULL, NULL, NULL, obj, NULL, NULL, vtype,
 	NULL);
 	if (e) {
-		printf("ERROR %d GRBaddvars(): %s\n", e, GRBgeterrormsg(*env));
-		free(obj);
+		printf("ERROR %d GRBaddvars(): %s\n", e, GRBgeterrormsg(workspace.env));
 		return 0;
 	}
 
 	e = GRBsetintattr(*model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
 	if (e) {
-		printf("ERROR %d GRBsetintattr(): %s\n", e, GRBgeterrormsg(*env));
-		free(obj);
+		printf("ERROR %d GRBsetintattr(): %s\n", e, GRBgeterrormsg(workspace.env));
 		return 0;
 	}
 
 	e = GRBupdatemodel(*model);
 	if (e) {
-		printf("ERROR %d GRBupdatemodel(): %s\n", e, GRBgeterrormsg(*env));
-		free(obj);
+		printf("ERROR %d GRBupdatemodel(): %s\n", e, GRBgeterrormsg(workspace.env));
 		return 0;
 	}
 
-	free(obj);
 	return 1;
 }
 
 /*
  * Function: add_constraints
  * ----------------------
- * 	Receives environment, model, types, objectives and ind arrays, indexes array, and relevant info regarding
- * 	the environment variables and add the constraints to the Gurobi model.
+ * 	Receives board, model and variables map, assembles all the constraints of the board in the CSR
+ * 	buffers of the workspace and adds them to the Gurobi model in one call: every empty cell has
+ * 	one value, and every row, column and block has one of each value it misses. The variables'
+ * 	lower bound is 0 already, so no constraint is needed for it. The variables of a unit are
+ * 	bucketed by value in one pass over its cells, so every variable is visited once per constraint
+ * 	it is in.
  *
  */
-int add_constraints(Board* game, GRBenv** env, GRBmodel** model, double** obj,
-		int** ind, int* indexes, int count) {
-	int i, j, k, f, g, e = 0, inde = 0, curr = 0;
-	int single_ind[1] = { 0 };
-	double single_obj[1] = { 1 };
-
-	/*Adding cons. #0 each value of the program is at least 0...\n")*/
-	for (i = 0; i < count; i++) {
-		single_ind[0] = i;
-		e = GRBaddconstr(*model, 1, single_ind, single_obj,
-		GRB_GREATER_EQUAL, 0.0, "c0");
-		if (e) {
-			printf("ERROR %d constraint #0: %s\n", e, GRBgeterrormsg(*env));
-			return 0;
-		}
-	}
-
-	/*"Adding cons. #1 each cell has one value...\n")*/
-	for (i = 0; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			if (game->current[i][j].value == DEFAULT) {
-				for (k = 0; k < game->current[i][j].options->length; k++) {
-					(*ind)[k] = inde++;
-					(*obj)[k] = 1;
-				}
-				e = GRBaddconstr(*model, k, *ind, *obj,
-				GRB_EQUAL, 1.0, "c1");
-				if (e) {
-					printf("ERROR %d constraint #1: %s\n", e,
-							GRBgeterrormsg(*env));
-					return 0;
-				}
-			}
-		}
-	}
-
-	/*"Adding cons. #2 each row has one of each value...\n")*/
-	for (i = 0; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			inde = i * game->board_size * game->board_size + j;
-			curr = 0;
-			for (k = 0; k < game->board_size; k++) {
-				if (indexes[inde] > 0) {
-					(*ind)[curr] = indexes[inde] - 1;
-					(*obj)[curr++] = 1;
-				}
-				inde += game->board_size;
-			}
-			if (curr) {
-				e = GRBaddconstr(*model, curr, *ind, *obj,
-				GRB_EQUAL, 1.0, "c2");
-				if (e) {
-					printf("ERROR %d constraint #2: %s\n", e,
-							GRBgeterrormsg(*env));
-					return 0;
-				}
-			}
-		}
+int add_constraints(Board* game, GRBmodel** model, Variables* vars) {
+	int i, j, k, e = 0, inde = 0, rows = 0, nnz = 0, n = game->board_size;
+	int* cells;
+	int* beg = workspace.beg;
+	int* cind = workspace.cind;
+	int* next = workspace.value_next;
+
+	/* each cell has one value */
+	for (i = 0; i < game->board_size * game->board_size; i++) {
+		if (vars->cell_first[i] == vars->cell_first[i + 1])
+			continue;
+		beg[rows++] = nnz;
+		for (inde = vars->cell_first[i]; inde < vars->cell_first[i + 1]; inde++)
+			cind[nnz++] = inde;
 	}
 
-	/*"Adding cons. #3 each column has one of each value...\n")*/
-	for (i = 0; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			inde = i * game->board_size + j;
-			curr = 0;
-			for (k = 0; k < game->board_size; k++) {
-				if (indexes[inde] > 0) {
-					(*ind)[curr] = indexes[inde] - 1;
-					(*obj)[curr++] = 1;
-				}
-				inde += game->board_size * game->board_size;
-			}
-			if (curr) {
-				e = GRBaddconstr(*model, curr, *ind, *obj,
-				GRB_EQUAL, 1.0, "c3");
-				if (e) {
-					printf("ERROR %d constraint #3: %s\n", e,
-							GRBgeterrormsg(*env));
-					return 0;
-				}
-			}
+	/* each row, column and block has one of each value */
+	for (i = 0; i < game->geometry->units_count; i++) {
+		cells = unit_cells(game->geometry, i);
+		for (j = 1; j <= n; j++)
+			next[j] = 0;
+		for (k = 0; k < n; k++)
+			for (inde = vars->cell_first[cells[k]];
+					inde < vars->cell_first[cells[k] + 1]; inde++)
+				next[vars->var_value[inde]] += 1;
+		for (j = 1; j <= n; j++) { /* value */
+			if (next[j] == 0)
+				continue;
+			beg[rows++] = nnz;
+			nnz += next[j];
+			next[j] = beg[rows - 1];
 		}
+		for (k = 0; k < n; k++)
+			for (inde = vars->cell_first[cells[k]];
+					inde < vars->cell_first[cells[k] + 1]; inde++)
+				cind[next[vars->var_value[inde]]++] = inde;
 	}
 
-	/*"Adding cons. #4 each block has one of each value...\n");*/
-	for (i = 0; i < game->block_col; i++) {
-		for (j = 0; j < game->block_row; j++) {
-			for (g = 0; g < game->board_size; g++) { /* value */
-				curr = 0;
-				for (k = 0; k < game->block_row; k++) {
-					inde = (i * game->block_row + k) * game->board_size
-							* game->board_size
-							+ j * game->block_col * game->board_size + g;
-					for (f = 0; f < game->block_col; f++) {
-						if (indexes[inde] > 0) {
-							(*ind)[curr] = indexes[inde] - 1;
-							(*obj)[curr++] = 1;
-						}
-						inde += game->board_size;
-					}
-				}
-				if (curr) {
-					e = GRBaddconstr(*model, curr, *ind, *obj,
-					GRB_EQUAL, 1.0, "c4");
-					if (e) {
-						printf(
-								"ERROR %d constraint #4 i = %d, j = %d inde = %d: %s\n",
-								e, i, j, inde, GRBgeterrormsg(*env));
-						return 0;
-					}
-				}
-			}
-		}
+	workspace.rows = rows;
+	workspace.nnz = nnz;
+	e = GRBaddconstrs(*model, rows, nnz, beg, cind, workspace.cval,
+			workspace.sense, workspace.rhs, NULL);
+	if (e) {
+		printf("ERROR %d GRBaddconstrs(): %s\n", e,
+				GRBgeterrormsg(workspace.env));
+		return 0;
 	}
 
 	return 1;
@@ -274,117 +592,238 @@ int add_constraints(Board* game, GRBenv** env, GRBmodel** model, double** obj,
  * 	Receives the Gurobi output and allocates it to the game board.
  *
  */
-void ilp_solution_to_board(Board* game, double* sol, int* indexes) {
-	int i, j, k, index;
-
-	for (i = 0; i < game->board_size; i++)
-		for (j = 0; j < game->board_size; j++)
-			for (k = 0; k < game->board_size; k++) {
-				index = i * game->board_size * game->board_size
-						+ j * game->board_size + k;
-				if (indexes[index] > 0 && sol[indexes[index] - 1] >= 1.0) {
-					set_value(game, i + 1, j + 1, k + 1);
-					break;
-				}
+void ilp_solution_to_board(Board* game, double* sol, Variables* vars) {
+	int i, k;
+
+	for (i = 0; i < game->board_size * game->board_size; i++)
+		for (k = vars->cell_first[i]; k < vars->cell_first[i + 1]; k++)
+			if (sol[k] >= 1.0 && game->cells[i].value == DEFAULT) {
+				set_value(game, i / game->board_size + 1,
+						i % game->board_size + 1, vars->var_value[k]);
+				break;
 			}
 }
 
-int ilp(Board* game) {
-	int* indexes;
-	int count = 0, i, j, k, curr = 0, index = 1;
-	OptionNode* node;
-	GRBenv* env = NULL;
-	GRBmodel* model = NULL;
-	int e = 0;
-	double* sol;
-	int* ind;
-	double* obj;
-	char* vtype;
-	int optimstatus = 0;
-	int status = 1;
+/*
+ * Function: fix_cell
+ * ----------------------
+ * 	Fixes the variables of a cell of the live model to value, or frees them if value is 0.
+ *
+ * 	returns: 1 on success, 0 otherwise.
+ */
+int fix_cell(int cell, int value) {
+	int k, e = 0, v;
+
+	for (k = live.vars.cell_first[cell]; !e && k < live.vars.cell_first[cell + 1]; k++) {
+		v = live.vars.var_value[k];
+		e = GRBsetdblattrelement(live.model, GRB_DBL_ATTR_LB, k, v == value ? 1.0 : 0.0);
+		if (!e)
+			e = GRBsetdblattrelement(live.model, GRB_DBL_ATTR_UB, k,
+					value == DEFAULT || v == value ? 1.0 : 0.0);
+	}
+	if (e) {
+		printf("ERROR %d GRBsetdblattrelement(): %s\n", e,
+				GRBgeterrormsg(workspace.env));
+		return 0;
+	}
+	live.applied[cell] = (unsigned char) value;
+	return 1;
+}
 
-	for (i = 0; i < game->board_size; i++)
-		for (j = 0; j < game->board_size; j++)
-			if (game->current[i][j].value == DEFAULT)
-				if (game->current[i][j].options->length != 0)
-					count += game->current[i][j].options->length;
-				else
-					return 0;
+/*
+ * Function: sync_live_model
+ * ----------------------
+ * 	Brings the live model to the position of the board by fixing and freeing variables, if it can:
+ * 	the board must have the shape of the base, the same values in the cells filled in the base, and
+ * 	only values that have a variable in the cells empty in the base.
+ *
+ * 	returns: 1 if the live model is the model of the board, 0 if a new model is needed.
+ */
+int sync_live_model(Board* game) {
+	int i, value, cells_count = game->board_size * game->board_size;
 
-	indexes = (int*) calloc(
-			game->board_size * game->board_size * game->board_size,
-			sizeof(int));
-	if (!indexes) {
-		printf("%s", CALLOC_ERROR);
+	if (!live.model || live.board_size != game->board_size
+			|| live.block_row != game->block_row)
 		return 0;
+	for (i = 0; i < cells_count; i++) {
+		value = game->cells[i].value;
+		if (live.base[i] != DEFAULT) {
+			if (value != live.base[i])
+				return 0;
+		} else if (value != live.applied[i] && value != DEFAULT
+				&& variable_index(&live.vars, i, value) < 0)
+			return 0;
 	}
 
-	for (i = 0; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			curr = i * game->board_size * game->board_size
-					+ j * game->board_size;
-			if (game->current[i][j].value == DEFAULT) {
-				node = game->current[i][j].options->top;
-				while (indexes[curr + node->value - 1] == 0) {
-					indexes[curr + node->value - 1] = index++;
-					node = node->next;
-				}
-			} else {
-				indexes[curr + game->current[i][j].value - 1] = -1;
-			}
-		}
-	}
+	for (i = 0; i < cells_count; i++)
+		if (live.base[i] == DEFAULT && game->cells[i].value != live.applied[i]
+				&& !fix_cell(i, game->cells[i].value))
+			return 0;
+	return 1;
+}
 
-	ind = (int*) malloc(game->board_size * sizeof(int));
-	sol = (double*) malloc(count * sizeof(double));
-	obj = (double*) malloc(game->board_size * sizeof(double));
-	vtype = (char*) malloc(count * sizeof(char));
-	if (!ind || !sol || !obj || !vtype) {
-		printf("%s", MALLOC_ERROR);
-		exit(0);
-	}
+/*
+ * Function: build_live_model
+ * ----------------------
+ * 	Replaces the live model with a new model of the board, with the board as its base.
+ *
+ * 	returns: 1 on success, 0 if the board is found unsolvable (an empty cell has no options),
+ * 			 ILP_ERROR if the model couldn't be built.
+ */
+int build_live_model(Board* game) {
+	GRBmodel* model = NULL;
+	Variables* vars = &workspace.vars;
+	int i, status, cells_count = game->board_size * game->board_size;
 
-	status = create_environment(&env, &model, 0);
-	status = status
-			&& add_variables(&env, &model, &vtype, count, 0, indexes,
-					game->board_size);
+	if (live.model)
+		GRBfreemodel(live.model);
+	live.model = NULL;
+	if (!build_variables(game, vars))
+		return 0;
+
+	status = create_model(&model);
 	status = status
-			&& add_constraints(game, &env, &model, &obj, &ind, indexes, count);
+			&& add_variables(&model, vars->count, 0, vars, game->board_size);
+	status = status && add_constraints(game, &model, vars);
+	if (!status) {
+		if (model)
+			GRBfreemodel(model);
+		return ILP_ERROR;
+	}
+	ilp_models++;
+	if (ilp_debug)
+		dump_model("integerLinearProgram.lp", game->board_size);
+
+	if (cells_count + 1 > live.cells_capacity) {
+		live.cells_capacity = cells_count + 1;
+		live.vars.cell_first = (int*) safe_realloc(live.vars.cell_first,
+				sizeof(int) * live.cells_capacity);
+		live.base = (unsigned char*) safe_realloc(live.base, live.cells_capacity);
+		live.applied = (unsigned char*) safe_realloc(live.applied, live.cells_capacity);
+	}
+	if (vars->count + 1 > live.vars_capacity) {
+		live.vars_capacity = workspace.vars_capacity;
+		live.vars.var_value = (int*) safe_realloc(live.vars.var_value,
+				sizeof(int) * live.vars_capacity);
+	}
+	memcpy(live.vars.cell_first, vars->cell_first, sizeof(int) * (cells_count + 1));
+	memcpy(live.vars.var_value, vars->var_value, sizeof(int) * vars->count);
+	live.vars.count = vars->count;
+	for (i = 0; i < cells_count; i++) {
+		live.base[i] = (unsigned char) game->cells[i].value;
+		live.applied[i] = DEFAULT;
+	}
+	live.board_size = game->board_size;
+	live.block_row = game->block_row;
+	live.model = model;
+	return 1;
+}
 
-	if (status) {
-		e = GRBoptimize(model);
+/*
+ * Function: solve_live_model
+ * ----------------------
+ * 	Solves the board with the live model, syncing it or building a new one, and fills the board
+ * 	with the solution.
+ *
+ * 	returns: 1 if the board was filled, 0 if the board has no solution, ILP_ERROR if Gurobi failed.
+ */
+int solve_live_model(Board* game) {
+	int e = 0;
+	int optimstatus = 0;
+	int status = 1;
+	double start = wall_seconds();
+
+	if (sync_live_model(game))
+		ilp_reuses++;
+	else
+		status = build_live_model(game);
+	ilp_build_seconds += wall_seconds() - start;
+
+	if (status == 1) {
+		start = wall_seconds();
+		e = GRBoptimize(live.model);
+		ilp_solve_seconds += wall_seconds() - start;
 		if (e) {
-			printf("ERROR %d GRBoptimize(): %s\n", e, GRBgeterrormsg(env));
-			status = 0;
+			printf("ERROR %d GRBoptimize(): %s\n", e, GRBgeterrormsg(workspace.env));
+			status = ILP_ERROR;
 		}
-		e = GRBgetintattr(model, GRB_INT_ATTR_STATUS, &optimstatus);
+		e = GRBgetintattr(live.model, GRB_INT_ATTR_STATUS, &optimstatus);
 		if (e) {
-			printf("ERROR %d GRBgetintattr(): %s\n", e, GRBgeterrormsg(env));
-			status = 0;
+			printf("ERROR %d GRBgetintattr(): %s\n", e, GRBgeterrormsg(workspace.env));
+			status = ILP_ERROR;
 		}
 	}
+	if (status != 1)
+		return status;
 
-	if (optimstatus == GRB_OPTIMAL) {
-		e = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, count, sol);
-		if (e) {
-			printf("ERROR %d GRBgetdblattrarray(): %s\n", e,
-					GRBgeterrormsg(env));
-			status = 0;
-		}
-	} else
-		status = 0;
-
-	if (status) {
-		ilp_solution_to_board(game, sol, indexes);
+	/* only a proven infeasible model is a board without a solution, anything else is a failure */
+	if (optimstatus == GRB_INFEASIBLE || optimstatus == GRB_INF_OR_UNBD)
+		return 0;
+	if (optimstatus != GRB_OPTIMAL)
+		return ILP_ERROR;
+	e = GRBgetdblattrarray(live.model, GRB_DBL_ATTR_X, 0, live.vars.count,
+			workspace.sol);
+	if (e) {
+		printf("ERROR %d GRBgetdblattrarray(): %s\n", e,
+				GRBgeterrormsg(workspace.env));
+		return ILP_ERROR;
 	}
 
-	e = GRBwrite(model, "integerLinearProgram.lp");
-	if (e) {
-		printf("ERROR %d GRBgetdblattrarray(): %s\n", e, GRBgeterrormsg(env));
-		status = 0;
+	ilp_solution_to_board(game, workspace.sol, &live.vars);
+	return 1;
+}
+
+/*
+ * Function: count_options
+ * ----------------------
+ * 	Returns the amount of options of the empty cells of the board, which is the amount of
+ * 	variables a model of it has.
+ */
+long count_options(Board* game) {
+	int i;
+	long count = 0;
+
+	for (i = 0; i < game->board_size * game->board_size; i++)
+		if (game->cells[i].value == DEFAULT)
+			count += game->cells[i].options.length;
+	return count;
+}
+
+int ilp(Board* game) {
+	int i, status, n = game->board_size;
+	long options = count_options(game);
+	Search* search = create_search(game);
+	Board* residual;
+
+	/* presolve: propagate on a scratch state, Gurobi only gets what propagation can't decide */
+	if (!search_propagate(search)) {
+		destroy_search(search);
+		ilp_presolve_unsolvable++;
+		return 0;
+	}
+	if (search->empty_count == 0) {
+		for (i = 0; i < n * n; i++)
+			if (game->cells[i].value == DEFAULT)
+				set_value(game, i / n + 1, i % n + 1, search->values[i]);
+		destroy_search(search);
+		ilp_presolve_solved++;
+		ilp_presolve_eliminated += options;
+		return 1;
 	}
-	free_all(env, model, sol, ind, obj, vtype, indexes);
 
+	residual = create_board_copy(game);
+	for (i = 0; i < n * n; i++)
+		if (game->cells[i].value == DEFAULT && search->values[i] != DEFAULT)
+			set_value(residual, i / n + 1, i % n + 1, search->values[i]);
+	destroy_search(search);
+	ilp_presolve_eliminated += options - count_options(residual);
+
+	status = solve_live_model(residual);
+	if (status == 1)
+		for (i = 0; i < n * n; i++)
+			if (game->cells[i].value == DEFAULT)
+				set_value(game, i / n + 1, i % n + 1, residual->cells[i].value);
+	destroy_board(residual);
 	return status;
 }
 
@@ -394,26 +833,23 @@ int ilp(Board* game) {
  * 	Receives the Gurobi output and allocates it to the game board.
  *
  */
-void lp_solution_to_board(Board* game, double* sol, int* indexes, float th) {
-	int i, j, k, index, c, r, b;
-	int* tmp = (int*) malloc(sizeof(int) * game->board_size);
-	if (!tmp) {
-		printf("%s", MALLOC_ERROR);
-		exit(0);
-	}
+void lp_solution_to_board(Board* game, double* sol, Variables* vars, float th) {
+	int i, j, k, cell, index, c, r, b;
+	int* tmp = workspace.cind; /* the model is built, its entries buffer is free to use */
 
 	for (i = 0; i < game->board_size; i++) {
 		for (j = 0; j < game->board_size; j++) {
 			c = 0;
 			b = 0;
-			if (game->current[i][j].value == DEFAULT) {
-				for (k = 0; k < game->board_size; k++) {
-					index = i * game->board_size * game->board_size
-							+ j * game->board_size + k;
-					if (indexes[index] > 0 && sol[indexes[index] - 1] >= th
-							&& is_value_valid(game, i, j, k + 1)) {
-						tmp[c] = k + 1;
-						b += sol[indexes[index] - 1];
+			cell = CELL_INDEX(game, i, j);
+			if (game->cells[cell].value == DEFAULT) {
+				/* the variables of the cell, by increasing value */
+				for (index = vars->cell_first[cell];
+						index < vars->cell_first[cell + 1]; index++) {
+					k = vars->var_value[index];
+					if (sol[index] >= th && is_value_valid(game, i, j, k)) {
+						tmp[c] = k;
+						b += sol[index];
 						c += 1;
 					}
 				}
@@ -435,76 +871,41 @@ void lp_solution_to_board(Board* game, double* sol, int* indexes, float th) {
 }
 
 int lp(Board* game, float th, int type, int row, int col) {
-	int* indexes;
-	int count = 0, i, j, k, curr = 0, index = 1;
-	OptionNode* node;
-	GRBenv* env = NULL;
+	Variables* vars = &workspace.vars;
+	int count = 0, k, index;
 	GRBmodel* model = NULL;
 	int e = 0;
 	double* sol;
-	int* ind;
-	double* obj;
-	char* vtype;
 	int optimstatus = 0;
 	int status = 1;
+	double start = wall_seconds();
 
-	for (i = 0; i < game->board_size; i++)
-		for (j = 0; j < game->board_size; j++)
-			if (game->current[i][j].value == DEFAULT)
-				if (game->current[i][j].options->length != 0)
-					count += game->current[i][j].options->length;
-				else
-					return 0;
-
-	indexes = (int*) calloc(
-			game->board_size * game->board_size * game->board_size,
-			sizeof(int));
-	if (!indexes) {
-		printf("%s", CALLOC_ERROR);
-		exit(0);
-	}
-
-	for (i = 0; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			curr = i * game->board_size * game->board_size
-					+ j * game->board_size;
-			if (game->current[i][j].value == DEFAULT) {
-				node = game->current[i][j].options->top;
-				while (indexes[curr + node->value - 1] == 0) {
-					indexes[curr + node->value - 1] = index++;
-					node = node->next;
-				}
-			} else {
-				indexes[curr + game->current[i][j].value - 1] = -1;
-			}
-		}
-	}
-
-	ind = (int*) malloc(game->board_size * sizeof(int));
-	sol = (double*) malloc(count * sizeof(double));
-	obj = (double*) malloc(game->board_size * sizeof(double));
-	vtype = (char*) malloc(count * sizeof(char));
-	if (!ind || !sol || !obj || !vtype) {
-		printf("%s", MALLOC_ERROR);
-		exit(0);
-	}
+	if (!build_variables(game, vars))
+		return 0;
+	count = vars->count;
+	sol = workspace.sol;
 
-	status = create_environment(&env, &model, 1);
+	status = create_model(&model);
 	status = status
-			&& add_variables(&env, &model, &vtype, count, 1, indexes,
-					game->board_size);
-	status = status
-			&& add_constraints(game, &env, &model, &obj, &ind, indexes, count);
+			&& add_variables(&model, count, 1, vars, game->board_size);
+	status = status && add_constraints(game, &model, vars);
+	ilp_build_seconds += wall_seconds() - start;
+	ilp_models++;
+	/* dump before lp_solution_to_board takes over the workspace's entries buffer */
+	if (ilp_debug && status)
+		dump_model("linearProgram.lp", game->board_size);
 
 	if (status) {
+		start = wall_seconds();
 		e = GRBoptimize(model);
+		ilp_solve_seconds += wall_seconds() - start;
 		if (e) {
-			printf("ERROR %d GRBoptimize(): %s\n", e, GRBgeterrormsg(env));
+			printf("ERROR %d GRBoptimize(): %s\n", e, GRBgeterrormsg(workspace.env));
 			status = 0;
 		}
 		e = GRBgetintattr(model, GRB_INT_ATTR_STATUS, &optimstatus);
 		if (e) {
-			printf("ERROR %d GRBgetintattr(): %s\n", e, GRBgeterrormsg(env));
+			printf("ERROR %d GRBgetintattr(): %s\n", e, GRBgeterrormsg(workspace.env));
 			status = 0;
 		}
 	}
@@ -513,7 +914,7 @@ int lp(Board* game, float th, int type, int row, int col) {
 		e = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, count, sol);
 		if (e) {
 			printf("ERROR %d GRBgetdblattrarray(): %s\n", e,
-					GRBgeterrormsg(env));
+					GRBgeterrormsg(workspace.env));
 			status = 0;
 		}
 	} else
@@ -522,24 +923,18 @@ int lp(Board* game, float th, int type, int row, int col) {
 	if (type) {
 		if (status) {
 			for (k = 0; k < game->board_size; k++) {
-				index = row * game->board_size * game->board_size
-						+ col * game->board_size + k;
-				if (indexes[index] > 0 && sol[indexes[index] - 1] >= 0.000001)
-					printf("Value %d has %f%%\n", k + 1,
-							sol[indexes[index] - 1] * 100);
+				index = variable_index(vars, row * game->board_size + col,
+						k + 1);
+				if (index >= 0 && sol[index] >= 0.000001)
+					printf("Value %d has %f%%\n", k + 1, sol[index] * 100);
 			}
 		}
 	} else if (status) {
-		lp_solution_to_board(game, sol, indexes, th);
+		lp_solution_to_board(game, sol, vars, th);
 	}
 
-	e = GRBwrite(model, "linearProgram.lp");
-	if (e) {
-		printf("ERROR %d GRBgetdblattrarray(): %s\n", e, GRBgeterrormsg(env));
-		status = 0;
-	}
 
-	free_all(env, model, sol, ind, obj, vtype, indexes);
+	GRBfreemodel(model);
 
 	return status;
 }
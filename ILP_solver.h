@@ -11,14 +11,43 @@
 #include "gurobi_c.h"
 #include <time.h>
 
+/*
+ * The result of ilp when the solver failed (no environment, no license, a Gurobi error), as
+ * opposed to 0 for a board that has no solution.
+ */
+#define ILP_ERROR -1
+
+/*
+ * The amount of models ilp and lp built, the amount of times ilp reused its model instead, and the
+ * wall clock seconds they took to build (or update) the models and to solve them.
+ */
+extern long ilp_models;
+extern long ilp_reuses;
+extern double ilp_build_seconds;
+extern double ilp_solve_seconds;
+
+/*
+ * What the presolve of ilp did: the amount of boards it solved and found unsolvable without
+ * Gurobi, and the amount of variables it kept out of the models.
+ */
+extern long ilp_presolve_solved;
+extern long ilp_presolve_unsolvable;
+extern long ilp_presolve_eliminated;
+
 /*
  * Function: ilp
  * ----------------------
- * 	Receives a board and uses ILP to fill it.
+ * 	Receives a board and uses ILP to fill it. The board is presolved first by propagating naked and
+ * 	hidden singles (see search_propagate): a contradiction means there is no solution, a completed
+ * 	grid is the solution, and otherwise only the cells propagation left empty are modeled.
+ * 	The model is kept for the next call: when the next board only fills or clears cells that were
+ * 	empty when the model was built, their variables are fixed or freed and the model is solved
+ * 	again instead of being rebuilt.
  *
  * 	game : the board to be filled using ILP.
  *
- * 	returns: 1 if the ILP was able to fill the board, 0 otherwise.
+ * 	returns: 1 if the ILP was able to fill the board, 0 if the board has no solution, ILP_ERROR if
+ * 			 the solver failed.
  */
 int ilp(Board* game);
 
@@ -33,4 +62,23 @@ int ilp(Board* game);
  */
 int lp(Board* game, float th, int type, int row, int col);
 
+/*
+ * Function: ilp_set_debug
+ * ----------------------
+ * 	Turns the debug output of the solver on or off. In debug mode Gurobi logs to sudoku.log, and
+ * 	every model ilp and lp build is written to integerLinearProgram.lp or linearProgram.lp by a
+ * 	background thread. Out of debug mode the solver writes no files.
+ *
+ * 	debug : 1 to turn the debug output on, 0 to turn it off.
+ */
+void ilp_set_debug(int debug);
+
+/*
+ * Function: ilp_teardown
+ * ----------------------
+ * 	Waits for the model being written in debug mode, if any, and frees the Gurobi environment and
+ * 	the buffers the solver keeps between calls. The next call of ilp or lp creates them again.
+ */
+void ilp_teardown();
+
 #endif /* ILP_SOLVER_H_ */
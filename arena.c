@@ -0,0 +1,60 @@
+/*
+ * arena.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "arena.h"
+
+#define MALLOC_ERROR "Error: malloc has failed.\n"
+
+/*
+ * Function: align_up
+ * ----------------------
+ * 	Rounds offset up to the next multiple of align.
+ */
+size_t align_up(size_t offset, size_t align) {
+	return (offset + align - 1) & ~(align - 1);
+}
+
+void arena_init(Arena* arena, void* memory, size_t size) {
+	arena->memory = (char*) memory;
+	arena->used = 0;
+	arena->size = size;
+}
+
+void* arena_alloc(Arena* arena, size_t size, size_t align) {
+	size_t offset = align_up(arena->used, align);
+
+	if (offset + size > arena->size)
+		return NULL;
+	arena->used = offset + size;
+	return arena->memory + offset;
+}
+
+size_t arena_size(int count, size_t* sizes, size_t* aligns) {
+	size_t size = 0;
+	int i;
+
+	for (i = 0; i < count; i++)
+		size = align_up(size, aligns[i]) + sizes[i];
+	return size;
+}
+
+void* safe_malloc(size_t size) {
+	void* memory = malloc(size > 0 ? size : 1);
+	if (memory == NULL) {
+		printf(MALLOC_ERROR);
+		exit(0);
+	}
+	return memory;
+}
+
+void* safe_realloc(void* memory, size_t size) {
+	memory = realloc(memory, size > 0 ? size : 1);
+	if (memory == NULL) {
+		printf(MALLOC_ERROR);
+		exit(0);
+	}
+	return memory;
+}
@@ -0,0 +1,89 @@
+/*
+ * arena.h
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stddef.h>
+
+/*
+ * Structure: Arena
+ * ------------------
+ * 	A structure used to hand out pieces of a single memory block. The pieces are never freed
+ * 	one by one, the whole block is freed by its owner.
+ *
+ * 	memory : the beginning of the block.
+ * 	used : an integer representing how many bytes of the block were handed out.
+ * 	size : an integer representing the size of the block in bytes.
+ */
+typedef struct {
+	char* memory;
+	size_t used;
+	size_t size;
+} Arena;
+
+/*
+ * Function: arena_init
+ * ----------------------
+ * 	Receives an arena and a memory block, and makes the arena hand out pieces of that block.
+ *
+ * 	arena : the arena to initialize.
+ * 	memory : the memory block.
+ * 	size : the size of the memory block in bytes.
+ */
+void arena_init(Arena* arena, void* memory, size_t size);
+
+/*
+ * Function: arena_alloc
+ * ----------------------
+ * 	Receives an arena, a size and an alignment, and hands out the next piece of the block.
+ *
+ * 	arena : the arena to allocate from.
+ * 	size : the size of the piece in bytes.
+ * 	align : the alignment of the piece relative to the beginning of the block, a power of 2.
+ *
+ * 	returns: a pointer to the piece, or NULL if the block is too small.
+ */
+void* arena_alloc(Arena* arena, size_t size, size_t align);
+
+/*
+ * Function: arena_size
+ * ----------------------
+ * 	Receives the sizes and alignments of the pieces that will be allocated, and returns the size of
+ * 	the block needed to hold them all.
+ *
+ * 	count : the amount of pieces.
+ * 	sizes : the size of every piece in bytes.
+ * 	aligns : the alignment of every piece.
+ *
+ * 	returns: the size of the block in bytes.
+ */
+size_t arena_size(int count, size_t* sizes, size_t* aligns);
+
+/*
+ * Function: safe_malloc
+ * ----------------------
+ * 	Allocates size bytes, prints an error and exits the program if the allocation fails. A size of
+ * 	0 allocates a single byte, so the result is never NULL.
+ *
+ * 	size : the size of the memory in bytes.
+ *
+ * 	returns: a pointer to the memory.
+ */
+void* safe_malloc(size_t size);
+
+/*
+ * Function: safe_realloc
+ * ----------------------
+ * 	Reallocates memory to size bytes the way realloc does, prints an error and exits the program
+ * 	if the allocation fails.
+ *
+ * 	memory : the memory to reallocate, or NULL to allocate new memory.
+ * 	size : the new size of the memory in bytes.
+ *
+ * 	returns: a pointer to the memory.
+ */
+void* safe_realloc(void* memory, size_t size);
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,51 @@
+/*
+ * backend.c
+ */
+
+#include <string.h>
+#include "backend.h"
+#include "search.h"
+#include "ILP_solver.h"
+
+#define DEFAULT 0
+
+/*
+ * Function: native_solve
+ * ----------------------
+ * 	Solves the board with a propagating backtracking search and copies the solution to it.
+ */
+int native_solve(Board* game) {
+	int i, solved, n = game->board_size;
+	Search* search = create_search(game);
+
+	solved = search_solve(search);
+	if (solved)
+		for (i = 0; i < n * n; i++)
+			if (game->cells[i].value == DEFAULT)
+				set_value(game, i / n + 1, i % n + 1, search->values[i]);
+	destroy_search(search);
+	return solved;
+}
+
+/*
+ * Function: gurobi_solve
+ * ----------------------
+ * 	Solves the board with ilp.
+ */
+int gurobi_solve(Board* game) {
+	int solved = ilp(game);
+	return solved == ILP_ERROR ? SOLVE_ERROR : solved;
+}
+
+const SolverBackend native_backend = { "native", native_solve };
+const SolverBackend gurobi_backend = { "gurobi", gurobi_solve };
+
+const SolverBackend* find_backend(const char* name) {
+	static const SolverBackend* backends[] = { &native_backend, &gurobi_backend };
+	int i;
+
+	for (i = 0; i < (int) (sizeof(backends) / sizeof(backends[0])); i++)
+		if (!strcmp(name, backends[i]->name))
+			return backends[i];
+	return NULL;
+}
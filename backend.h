@@ -0,0 +1,47 @@
+/*
+ * backend.h
+ */
+
+#ifndef BACKEND_H_
+#define BACKEND_H_
+
+#include "game.h"
+
+/*
+ * The result of a backend's solve when the backend failed, rather than finding no solution.
+ */
+#define SOLVE_ERROR -1
+
+/*
+ * Structure: SolverBackend
+ * ------------------
+ * 	A structure holding a way to solve boards. validate, hint and generate solve through the
+ * 	selected backend, so they work the same whichever one it is.
+ *
+ * 	name : the name the backend is selected by.
+ * 	solve : fills the empty cells of the board with a solution of it and returns 1. Returns 0 if the
+ * 			board has no solution and SOLVE_ERROR if the backend failed, leaving the board
+ * 			untouched. Only 0 says anything about the board.
+ */
+typedef struct {
+	const char* name;
+	int (*solve)(Board* game);
+} SolverBackend;
+
+/*
+ * The backends: native solves with propagation and backtracking (see search.h) and needs no
+ * license, gurobi solves with the ILP model of ILP_solver.h.
+ */
+extern const SolverBackend native_backend;
+extern const SolverBackend gurobi_backend;
+
+/*
+ * Function: find_backend
+ * ----------------------
+ * 	Receives a name and returns the backend of that name.
+ *
+ * 	returns: the backend, or NULL if there is no backend of that name.
+ */
+const SolverBackend* find_backend(const char* name);
+
+#endif /* BACKEND_H_ */
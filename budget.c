@@ -0,0 +1,58 @@
+/*
+ * budget.c
+ */
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+
+#include <stdio.h>
+#include <time.h>
+#include "budget.h"
+
+double budget_clock() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+void budget_init(Budget* budget, int seconds, long max_nodes, int report) {
+	budget->start = budget_clock();
+	budget->deadline = seconds > 0 ? budget->start + seconds : 0;
+	budget->max_nodes = max_nodes > 0 ? max_nodes : 0;
+	budget->report = report;
+	budget->nodes = 0;
+	budget->solutions = 0;
+	budget->exhausted = 0;
+	budget->last_report = budget->start;
+	budget->last_nodes = 0;
+	pthread_mutex_init(&budget->lock, NULL);
+}
+
+int budget_charge(Budget* budget, long nodes, long solutions, int depth) {
+	int go_on;
+	double now = budget_clock(), seconds;
+
+	pthread_mutex_lock(&budget->lock);
+	budget->nodes += nodes;
+	budget->solutions += solutions;
+	if ((budget->max_nodes && budget->nodes >= budget->max_nodes)
+			|| (budget->deadline && now >= budget->deadline))
+		budget->exhausted = 1;
+
+	if (budget->report && !budget->exhausted && now - budget->last_report >= 1) {
+		seconds = now - budget->last_report;
+		printf("Progress: %ld nodes (%.0f nodes/s), depth %d, %ld solutions so far\n",
+				budget->nodes, (budget->nodes - budget->last_nodes) / seconds,
+				depth, budget->solutions);
+		fflush(stdout);
+		budget->last_report = now;
+		budget->last_nodes = budget->nodes;
+	}
+	go_on = !budget->exhausted;
+	pthread_mutex_unlock(&budget->lock);
+	return go_on;
+}
+
+void budget_destroy(Budget* budget) {
+	pthread_mutex_destroy(&budget->lock);
+}
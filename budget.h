@@ -0,0 +1,88 @@
+/*
+ * budget.h
+ */
+
+#ifndef BUDGET_H_
+#define BUDGET_H_
+
+#include <pthread.h>
+
+/*
+ * The amount of search nodes a search runs between two charges of its budget.
+ */
+#define BUDGET_BATCH 1024
+
+/*
+ * Structure: Budget
+ * ------------------
+ * 	The time and nodes a search may use, shared by all the threads of the search. The searches charge
+ * 	it every BUDGET_BATCH nodes, and it prints the progress of the search about once a second.
+ *
+ * 	max_nodes : the amount of nodes the search may visit, 0 for no limit.
+ * 	deadline : the time the search must stop at, 0 for no limit. Times are seconds of a monotonic
+ * 			clock (see budget_clock).
+ * 	report : 1 if progress should be printed, 0 otherwise.
+ * 	nodes : the amount of nodes visited so far.
+ * 	solutions : the amount of solutions found so far.
+ * 	exhausted : 1 once the time or the nodes ran out, 0 before.
+ * 	start : the time the search started at.
+ * 	last_report : the time the progress was last printed at.
+ * 	last_nodes : the amount of nodes visited when the progress was last printed.
+ * 	lock : protects the fields above when several threads share the budget.
+ */
+typedef struct {
+	long max_nodes;
+	double deadline;
+	int report;
+	long nodes;
+	long solutions;
+	int exhausted;
+	double start;
+	double last_report;
+	long last_nodes;
+	pthread_mutex_t lock;
+} Budget;
+
+/*
+ * Function: budget_clock
+ * ----------------------
+ * 	Returns the seconds of a monotonic wall clock, with sub-second precision so a deadline is
+ * 	the same length wherever in a second the search starts.
+ */
+double budget_clock();
+
+/*
+ * Function: budget_init
+ * ----------------------
+ * 	Receives a budget and its limits, and starts it.
+ *
+ * 	budget : the budget to start.
+ * 	seconds : the wall clock seconds the search may run, 0 for no limit.
+ * 	max_nodes : the amount of nodes the search may visit, 0 for no limit.
+ * 	report : 1 if progress should be printed, 0 otherwise.
+ */
+void budget_init(Budget* budget, int seconds, long max_nodes, int report);
+
+/*
+ * Function: budget_charge
+ * ----------------------
+ * 	Receives a budget and what a search did since its last charge, adds it to the budget, checks the
+ * 	limits and prints the progress if it is time to.
+ *
+ * 	budget : the budget to charge.
+ * 	nodes : the amount of nodes visited since the last charge.
+ * 	solutions : the amount of solutions found since the last charge.
+ * 	depth : the current depth of the search.
+ *
+ * 	returns: 1 if the search may go on, 0 if the budget is exhausted.
+ */
+int budget_charge(Budget* budget, long nodes, long solutions, int depth);
+
+/*
+ * Function: budget_destroy
+ * ------------------------
+ * 	Used to release the resources of a budget started by budget_init.
+ */
+void budget_destroy(Budget* budget);
+
+#endif /* BUDGET_H_ */
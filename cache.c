@@ -0,0 +1,166 @@
+/*
+ * cache.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "cache.h"
+
+#define MALLOC_ERROR "Error: malloc has failed\n"
+
+long cache_hits = 0;
+long cache_misses = 0;
+
+CacheEntry cache_entries[CACHE_ENTRIES];
+
+/*
+ * Function: same_position
+ * ----------------------
+ * 	Returns 1 if the entry holds the position of the board, 0 otherwise.
+ */
+int same_position(CacheEntry* entry, Board* game) {
+	int i;
+
+	if (!entry->values || entry->hash != game->hash
+			|| entry->board_size != game->board_size
+			|| entry->block_row != game->block_row)
+		return 0;
+	for (i = 0; i < game->board_size * game->board_size; i++)
+		if (entry->values[i] != game->cells[i].value)
+			return 0;
+	return 1;
+}
+
+/*
+ * Function: free_entry
+ * ----------------------
+ * 	Frees the memory of an entry and marks it unused.
+ */
+void free_entry(CacheEntry* entry) {
+	free(entry->values);
+	free(entry->solution);
+	entry->values = NULL;
+	entry->solution = NULL;
+}
+
+/*
+ * Function: copy_values
+ * ----------------------
+ * 	Returns a new array with the values of the cells of the board.
+ */
+unsigned char* copy_values(Board* game) {
+	int i, cells_count = game->board_size * game->board_size;
+	unsigned char* values = (unsigned char*) malloc(cells_count);
+	if (!values) {
+		printf("%s", MALLOC_ERROR);
+		exit(0);
+	}
+	for (i = 0; i < cells_count; i++)
+		values[i] = (unsigned char) game->cells[i].value;
+	return values;
+}
+
+/*
+ * Function: find_entry
+ * ----------------------
+ * 	Returns the entry of the board's position. If the position has no entry and create is 1, the entry
+ * 	of its slot is replaced by a new empty entry for it.
+ *
+ * 	returns: the entry, or NULL if there is none and create is 0.
+ */
+CacheEntry* find_entry(Board* game, int create) {
+	CacheEntry* entry = &cache_entries[game->hash % CACHE_ENTRIES];
+
+	if (same_position(entry, game))
+		return entry;
+	if (!create)
+		return NULL;
+
+	free_entry(entry);
+	entry->hash = game->hash;
+	entry->board_size = game->board_size;
+	entry->block_row = game->block_row;
+	entry->values = copy_values(game);
+	entry->solvable = -1;
+	entry->count = -1;
+	entry->count_exact = 0;
+	return entry;
+}
+
+int cache_get_solvable(Board* game) {
+	CacheEntry* entry = find_entry(game, 0);
+
+	if (!entry || entry->solvable < 0) {
+		cache_misses++;
+		return -1;
+	}
+	cache_hits++;
+	return entry->solvable;
+}
+
+int cache_get_solution_value(Board* game, int cell) {
+	CacheEntry* entry = find_entry(game, 0);
+
+	if (entry && entry->solvable == 0) {
+		cache_hits++;
+		return -1;
+	}
+	if (!entry || !entry->solution) {
+		cache_misses++;
+		return 0;
+	}
+	cache_hits++;
+	return entry->solution[cell];
+}
+
+int cache_get_count(Board* game, int limit) {
+	CacheEntry* entry = find_entry(game, 0);
+
+	if (entry && entry->count >= 0) {
+		/* a lower bound only answers limits it reached */
+		if (limit > 0 && entry->count >= limit) {
+			cache_hits++;
+			return limit;
+		}
+		if (entry->count_exact) {
+			cache_hits++;
+			return entry->count;
+		}
+	}
+	cache_misses++;
+	return -1;
+}
+
+void cache_put_solution(Board* game, Board* solution) {
+	CacheEntry* entry = find_entry(game, 1);
+
+	entry->solvable = 1;
+	if (!entry->solution)
+		entry->solution = copy_values(solution);
+}
+
+void cache_put_unsolvable(Board* game) {
+	CacheEntry* entry = find_entry(game, 1);
+
+	entry->solvable = 0;
+	entry->count = 0;
+	entry->count_exact = 1;
+}
+
+void cache_put_count(Board* game, int count, int exact) {
+	CacheEntry* entry = find_entry(game, 1);
+
+	if (!entry->count_exact && count >= entry->count) {
+		entry->count = count;
+		entry->count_exact = exact;
+	}
+	if (exact || count > 0)
+		entry->solvable = count > 0;
+}
+
+void cache_clear() {
+	int i;
+
+	for (i = 0; i < CACHE_ENTRIES; i++)
+		free_entry(&cache_entries[i]);
+}
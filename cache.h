@@ -0,0 +1,113 @@
+/*
+ * cache.h
+ */
+
+#ifndef CACHE_H_
+#define CACHE_H_
+
+#include "game.h"
+
+/*
+ * The amount of positions the cache remembers.
+ */
+#define CACHE_ENTRIES 64
+
+/*
+ * Structure: CacheEntry
+ * ------------------
+ * 	The known solver results of a board position. Entries are found by the board's hash, and the
+ * 	values of the position are kept to tell positions with the same hash apart.
+ *
+ * 	hash : the hash of the position.
+ * 	board_size : an integer representing how many rows and columns the board have.
+ * 	block_row : an integer representing how many rows every block have.
+ * 	values : the values of the cells of the position, NULL for an unused entry.
+ * 	solvable : 1 if the position is solvable, 0 if it isn't, -1 if unknown.
+ * 	solution : the values of the cells of a solution of the position, NULL if unknown.
+ * 	count : the amount of solutions of the position, or a lower bound of it, -1 if unknown.
+ * 	count_exact : 1 if count is the amount of solutions, 0 if it is a lower bound.
+ */
+typedef struct {
+	unsigned long hash;
+	int board_size;
+	int block_row;
+	unsigned char* values;
+	int solvable;
+	unsigned char* solution;
+	int count;
+	int count_exact;
+} CacheEntry;
+
+/*
+ * The amount of queries the cache answered and couldn't answer.
+ */
+extern long cache_hits;
+extern long cache_misses;
+
+/*
+ * Function: cache_get_solvable
+ * ----------------------
+ * 	Receives a board and looks up whether it is solvable.
+ *
+ * 	returns: 1 if it is solvable, 0 if it isn't, -1 if unknown.
+ */
+int cache_get_solvable(Board* game);
+
+/*
+ * Function: cache_get_solution_value
+ * ----------------------
+ * 	Receives a board and a cell and looks up the value of the cell in a solution of the board.
+ *
+ * 	game : the board.
+ * 	cell : the linear index of the cell.
+ *
+ * 	returns: the value, -1 if the board is known to be unsolvable, 0 if no solution is known.
+ */
+int cache_get_solution_value(Board* game, int cell);
+
+/*
+ * Function: cache_get_count
+ * ----------------------
+ * 	Receives a board and a limit and looks up its amount of solutions, as count_solutions would return
+ * 	it for that limit.
+ *
+ * 	game : the board.
+ * 	limit : the amount of solutions to stop at, 0 to count them all.
+ *
+ * 	returns: the amount of solutions, or limit if there are at least limit solutions, -1 if unknown.
+ */
+int cache_get_count(Board* game, int limit);
+
+/*
+ * Function: cache_put_solution
+ * ----------------------
+ * 	Receives a board and a solution of it and remembers that the board is solvable, with that solution.
+ */
+void cache_put_solution(Board* game, Board* solution);
+
+/*
+ * Function: cache_put_unsolvable
+ * ----------------------
+ * 	Receives a board and remembers that it isn't solvable.
+ */
+void cache_put_unsolvable(Board* game);
+
+/*
+ * Function: cache_put_count
+ * ----------------------
+ * 	Receives a board and an amount of solutions of it, and remembers it.
+ *
+ * 	game : the board.
+ * 	count : the amount of solutions, or a lower bound of it.
+ * 	exact : 1 if count is the amount of solutions, 0 if it is a lower bound.
+ */
+void cache_put_count(Board* game, int count, int exact);
+
+/*
+ * Function: cache_clear
+ * ----------------------
+ * 	Forgets all the positions and frees the memory of the cache.
+ */
+void cache_clear();
+
+#endif /* CACHE_H_ */
@@ -0,0 +1,226 @@
+/*
+ * dlx.c
+ */
+
+#include <stdlib.h>
+#include "dlx.h"
+#include "arena.h"
+
+#define DEFAULT 0
+
+/*
+ * Function: append_node
+ * ----------------------
+ * 	Adds a node at the bottom of column, to the left of first (or alone if first is -1).
+ *
+ * 	returns: the index of the new node.
+ */
+int append_node(Dlx* dlx, int column, int first) {
+	int node = dlx->nodes_count++;
+
+	dlx->column[node] = column;
+	dlx->down[node] = column;
+	dlx->up[node] = dlx->up[column];
+	dlx->down[dlx->up[column]] = node;
+	dlx->up[column] = node;
+	dlx->size[column] += 1;
+
+	if (first < 0) {
+		dlx->left[node] = node;
+		dlx->right[node] = node;
+	} else {
+		dlx->right[node] = first;
+		dlx->left[node] = dlx->left[first];
+		dlx->right[dlx->left[first]] = node;
+		dlx->left[first] = node;
+	}
+	return node;
+}
+
+Dlx* create_dlx(Board* game) {
+	int n = game->board_size, cells_count = n * n;
+	int i, j, value, rows_count = 0, column, first;
+	int* cell_column = (int*) safe_malloc(sizeof(int) * cells_count);
+	int* unit_column = (int*) safe_malloc(
+			sizeof(int) * game->geometry->units_count * n);
+	int* units;
+	Dlx* dlx = (Dlx*) safe_malloc(sizeof(Dlx));
+
+	/* one column for every empty cell and every missing value of every unit */
+	dlx->columns_count = 0;
+	dlx->depth = 0;
+	dlx->budget = NULL;
+	for (i = 0; i < cells_count; i++) {
+		cell_column[i] = -1;
+		if (game->cells[i].value == DEFAULT) {
+			cell_column[i] = ++dlx->columns_count;
+			rows_count += game->cells[i].options.length;
+			dlx->depth += 1;
+		}
+	}
+	for (i = 0; i < game->geometry->units_count; i++)
+		for (value = 1; value <= n; value++)
+			unit_column[i * n + value - 1] =
+					options_contains(&game->units_used[i], value) ?
+							-1 : ++dlx->columns_count;
+
+	dlx->nodes_count = 1 + dlx->columns_count
+			+ (1 + UNITS_PER_CELL) * rows_count;
+	dlx->left = (int*) safe_malloc(sizeof(int) * dlx->nodes_count);
+	dlx->right = (int*) safe_malloc(sizeof(int) * dlx->nodes_count);
+	dlx->up = (int*) safe_malloc(sizeof(int) * dlx->nodes_count);
+	dlx->down = (int*) safe_malloc(sizeof(int) * dlx->nodes_count);
+	dlx->column = (int*) safe_malloc(sizeof(int) * dlx->nodes_count);
+	dlx->size = (int*) safe_malloc(sizeof(int) * (dlx->columns_count + 1));
+	dlx->choices = (int*) safe_malloc(sizeof(int) * dlx->depth);
+
+	for (i = 0; i <= dlx->columns_count; i++) {
+		dlx->left[i] = i - 1;
+		dlx->right[i] = i + 1;
+		dlx->up[i] = i;
+		dlx->down[i] = i;
+		dlx->column[i] = i;
+		dlx->size[i] = 0;
+	}
+	dlx->left[DLX_ROOT] = dlx->columns_count;
+	dlx->right[dlx->columns_count] = DLX_ROOT;
+
+	/* one row for every option of every empty cell */
+	dlx->nodes_count = dlx->columns_count + 1;
+	for (i = 0; i < cells_count; i++) {
+		if (cell_column[i] < 0)
+			continue;
+		units = &game->geometry->cell_units[i * UNITS_PER_CELL];
+		for (value = options_next(&game->cells[i].options, 0); value;
+				value = options_next(&game->cells[i].options, value)) {
+			first = append_node(dlx, cell_column[i], -1);
+			for (j = 0; j < UNITS_PER_CELL; j++) {
+				column = unit_column[units[j] * n + value - 1];
+				append_node(dlx, column, first);
+			}
+		}
+	}
+
+	free(cell_column);
+	free(unit_column);
+	return dlx;
+}
+
+/*
+ * Function: cover
+ * ----------------------
+ * 	Removes a column from the header list, and all the rows of the column from the other columns.
+ */
+void cover(Dlx* dlx, int column) {
+	int i, j;
+
+	dlx->right[dlx->left[column]] = dlx->right[column];
+	dlx->left[dlx->right[column]] = dlx->left[column];
+	for (i = dlx->down[column]; i != column; i = dlx->down[i])
+		for (j = dlx->right[i]; j != i; j = dlx->right[j]) {
+			dlx->down[dlx->up[j]] = dlx->down[j];
+			dlx->up[dlx->down[j]] = dlx->up[j];
+			dlx->size[dlx->column[j]] -= 1;
+		}
+}
+
+/*
+ * Function: uncover
+ * ----------------------
+ * 	Reverts cover, in the opposite order.
+ */
+void uncover(Dlx* dlx, int column) {
+	int i, j;
+
+	for (i = dlx->up[column]; i != column; i = dlx->up[i])
+		for (j = dlx->left[i]; j != i; j = dlx->left[j]) {
+			dlx->size[dlx->column[j]] += 1;
+			dlx->down[dlx->up[j]] = j;
+			dlx->up[dlx->down[j]] = j;
+		}
+	dlx->right[dlx->left[column]] = column;
+	dlx->left[dlx->right[column]] = column;
+}
+
+int dlx_choose_column(Dlx* dlx) {
+	int i, best = dlx->right[DLX_ROOT];
+
+	for (i = dlx->right[best]; i != DLX_ROOT; i = dlx->right[i])
+		if (dlx->size[i] < dlx->size[best])
+			best = i;
+	return best;
+}
+
+void dlx_select(Dlx* dlx, int node) {
+	int j;
+
+	cover(dlx, dlx->column[node]);
+	for (j = dlx->right[node]; j != node; j = dlx->right[j])
+		cover(dlx, dlx->column[j]);
+}
+
+void dlx_deselect(Dlx* dlx, int node) {
+	int j;
+
+	for (j = dlx->left[node]; j != node; j = dlx->left[j])
+		uncover(dlx, dlx->column[j]);
+	uncover(dlx, dlx->column[node]);
+}
+
+int dlx_count_solutions(Dlx* dlx, int limit) {
+	int count = 0, charged = 0, level = 0, stop = 0, node, column, j;
+	long nodes = 0;
+
+	for (;;) {
+		if (dlx->right[DLX_ROOT] == DLX_ROOT) {
+			count += 1;
+			stop = stop || (limit > 0 && count >= limit);
+			node = -1;
+		} else {
+			column = dlx_choose_column(dlx);
+			cover(dlx, column);
+			node = dlx->down[column];
+		}
+
+		/* try node at this level, or backtrack until a level has a next row to try.
+		 * once the limit is reached or the budget is exhausted, backtrack all the way up */
+		for (;;) {
+			if (node >= 0 && node != dlx->column[node] && !stop && dlx->budget
+					&& ++nodes == BUDGET_BATCH) {
+				stop = !budget_charge(dlx->budget, nodes, count - charged, level);
+				charged = count;
+				nodes = 0;
+			}
+			if (node >= 0 && node != dlx->column[node] && !stop) {
+				dlx->choices[level++] = node;
+				for (j = dlx->right[node]; j != node; j = dlx->right[j])
+					cover(dlx, dlx->column[j]);
+				break;
+			}
+			if (node >= 0)
+				uncover(dlx, dlx->column[node]);
+			if (level == 0) {
+				if (dlx->budget)
+					budget_charge(dlx->budget, nodes, count - charged, 0);
+				return count;
+			}
+			node = dlx->choices[--level];
+			for (j = dlx->left[node]; j != node; j = dlx->left[j])
+				uncover(dlx, dlx->column[j]);
+			node = dlx->down[node];
+		}
+	}
+}
+
+void destroy_dlx(Dlx* dlx) {
+	if (!dlx)
+		return;
+	free(dlx->left);
+	free(dlx->right);
+	free(dlx->up);
+	free(dlx->down);
+	free(dlx->column);
+	free(dlx->size);
+	free(dlx->choices);
+	free(dlx);
+}
@@ -0,0 +1,106 @@
+/*
+ * dlx.h
+ */
+
+#ifndef DLX_H_
+#define DLX_H_
+
+#include "game.h"
+#include "budget.h"
+
+/*
+ * The index of the root node, the columns list starts at its right.
+ */
+#define DLX_ROOT 0
+
+/*
+ * Structure: Dlx
+ * ------------------
+ * 	A structure used to represent a sudoku board as an exact cover problem, solved with
+ * 	Knuth's Algorithm X over dancing links. The columns are the constraints the ILP model uses
+ * 	(every empty cell has one value, every row, column and block has each missing value once),
+ * 	the rows are the options of the empty cells. Nodes are stored in arrays and linked by index,
+ * 	node 0 is the root and nodes 1..columns_count are the column headers.
+ *
+ * 	left, right, up, down : for every node, the index of its neighbour in that direction.
+ * 	column : for every node, the index of its column header.
+ * 	size : for every column header, the amount of rows in the column.
+ * 	nodes_count : the amount of nodes.
+ * 	columns_count : the amount of columns.
+ * 	choices : for every level of the search, the row node chosen at it.
+ * 	depth : the amount of levels of the search (the amount of empty cells).
+ * 	budget : the budget the counts of the matrix are charged to, NULL for no budget.
+ */
+typedef struct {
+	int* left;
+	int* right;
+	int* up;
+	int* down;
+	int* column;
+	int* size;
+	int nodes_count;
+	int columns_count;
+	int* choices;
+	int depth;
+	Budget* budget;
+} Dlx;
+
+/*
+ * Function: create_dlx
+ * ----------------------
+ * 	Receives a board and builds its exact cover matrix.
+ *
+ * 	game : the board to build the matrix of.
+ *
+ * 	returns: a pointer to the matrix.
+ */
+Dlx* create_dlx(Board* game);
+
+/*
+ * Function: dlx_choose_column
+ * ----------------------
+ * 	Receives an exact cover matrix with uncovered columns and returns the column with the fewest rows.
+ */
+int dlx_choose_column(Dlx* dlx);
+
+/*
+ * Function: dlx_select
+ * ----------------------
+ * 	Receives an exact cover matrix and a row node, and puts the row in the cover: covers all the
+ * 	columns of the row, so only rows that don't conflict with it are left.
+ */
+void dlx_select(Dlx* dlx, int node);
+
+/*
+ * Function: dlx_deselect
+ * ----------------------
+ * 	Reverts dlx_select. Rows must be deselected in the opposite order of their selection.
+ */
+void dlx_deselect(Dlx* dlx, int node);
+
+/*
+ * Function: dlx_count_solutions
+ * ----------------------
+ * 	Receives an exact cover matrix and counts its exact covers, which are the solutions of the board
+ * 	it was built from, including the rows already selected. The count stops as soon as limit covers
+ * 	are found, or when the budget of the matrix is exhausted. The matrix is restored to its state
+ * 	before the call when the count is done.
+ *
+ * 	dlx : the matrix to count the covers of.
+ * 	limit : the amount of covers to stop at, 0 to count them all.
+ *
+ * 	returns: the amount of solutions, or limit if there are at least limit solutions. If the budget
+ * 			 was exhausted, the amount of solutions found until then.
+ */
+int dlx_count_solutions(Dlx* dlx, int limit);
+
+/*
+ * Function: destroy_dlx
+ * ------------------------
+ * 	Used to destroy an exact cover matrix and free the memory allocated to it.
+ *
+ * 	dlx : a pointer to the matrix.
+ */
+void destroy_dlx(Dlx* dlx);
+
+#endif /* DLX_H_ */
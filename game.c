@@ -19,67 +19,11 @@ game_mode current_game_mode = GAME_MODE_INIT;
 int mark_errors = 1;
 
 int insert_option(Cell* cell, int value) {
-	int index = 0;
-	OptionNode* last;
-	OptionNode* tmp;
-
-	if (cell->options->length == 0) {
-		if ((tmp = (OptionNode *) malloc(sizeof(OptionNode))) == NULL) {
-			printf(MALLOC_ERROR);
-			exit(0);
-		}
-		cell->options->top = tmp;
-		cell->options->top->prev = tmp;
-		cell->options->top->next = tmp;
-		tmp->value = value;
-		cell->options->length += 1;
-		return 1;
-	}
-
-	last = cell->options->top->prev;
-	tmp = cell->options->top;
-	while (index < cell->options->length) {
-		if (tmp->value == value)
-			return 1;
-		tmp = tmp->next;
-		index++;
-	}
-	tmp = NULL;
-
-	if ((tmp = (OptionNode *) malloc(sizeof(OptionNode))) == NULL) {
-		printf(MALLOC_ERROR);
-		exit(0);
-	}
-	tmp->value = value;
-	tmp->next = cell->options->top;
-	tmp->prev = last;
-	last->next = tmp;
-	cell->options->top->prev = tmp;
-	cell->options->length = cell->options->length + 1;
-
-	return 1;
+	return options_insert(&cell->options, value);
 }
 
 int remove_option(Cell* cell, int value) {
-	OptionNode* curr = cell->options->top;
-	int count = 1;
-
-	while (curr->value != value) {
-		curr = curr->next;
-		if (count == cell->options->length) {
-			return 0;
-		}
-		count++;
-	}
-	if (curr == cell->options->top)
-		cell->options->top = curr->next;
-	curr->prev->next = curr->next;
-	curr->next->prev = curr->prev;
-	free(curr);
-
-	cell->options->length = cell->options->length - 1;
-
-	return 0;
+	return options_remove(&cell->options, value);
 }
 
 /*
@@ -102,12 +46,21 @@ void print_separator_row(int row_length) {
 	free(line);
 }
 
+/*
+ * Function: cell_width
+ * ----------------------
+ * 	Returns the amount of digits a value of a board of size {board_size} may take.
+ */
+int cell_width(int board_size) {
+	return board_size > 99 ? 3 : 2;
+}
+
 /*
  * Function: print_cell
  * ----------------------
- * 	Receives a cell and prints it in the correct format.
+ * 	Receives a cell and prints it in the correct format, with its value padded to {width} digits.
  */
-void print_cell(Cell *cell) {
+void print_cell(Cell *cell, int width) {
 	char extra_sign;
 	int val = cell->value;
 	if (cell->isFixed && current_game_mode != GAME_MODE_EDIT) {
@@ -121,9 +74,9 @@ void print_cell(Cell *cell) {
 		}
 	}
 	if (val)
-		printf(" %2d%c", val, extra_sign);
+		printf(" %*d%c", width, val, extra_sign);
 	else
-		printf("   %c", extra_sign);
+		printf(" %*s%c", width, "", extra_sign);
 }
 
 /*
@@ -133,11 +86,11 @@ void print_cell(Cell *cell) {
  * 	format.
  */
 void print_row(Board *board, int index) {
-	int j = 0, i;
+	int j = 0, i, width = cell_width(board->board_size);
 	printf("|");
 	while (j < board->board_size) {
 		for (i = 0; i < board->block_col; i++) {
-			print_cell(&board->current[index][j]);
+			print_cell(GET_CELL(board, index, j), width);
 			j++;
 		}
 		printf("|");
@@ -147,7 +100,8 @@ void print_row(Board *board, int index) {
 
 void print_board(Board* board) {
 	int index = 0, j;
-	int row_length = 4 * board->board_size + board->block_row + 1;
+	int row_length = (cell_width(board->board_size) + 2) * board->board_size
+			+ board->block_row + 1;
 	print_separator_row(row_length);
 	while (index < board->board_size) {
 		for (j = 0; j < board->block_row; j++) {
@@ -159,164 +113,98 @@ void print_board(Board* board) {
 }
 
 int is_value_valid(Board* game, int row, int col, int value) {
-	int i = 0, j = 0;
-	int rows_to_add = 0, cols_to_add = 0;
-
-	for (; i < game->board_size; i++) {
-		if (game->current[row][i].value == value) {
-			return 0;
-		}
-		if (game->current[i][col].value == value) {
-			return 0;
-		}
-	}
-
-	rows_to_add = (row / game->block_row) * game->block_row;
-	cols_to_add = (col / game->block_col) * game->block_col;
-
-	for (i = rows_to_add; i < rows_to_add + game->block_row; i++)
-		for (j = cols_to_add; j < cols_to_add + game->block_col; j++)
-			if (game->current[i][j].value == value) {
-				return 0;
-			}
-
-	return 1;
+	return game->kernels->is_value_valid(game, CELL_INDEX(game, row, col),
+			value);
 }
 
-void check_specific_error(Board* game, int row, int col) {
-	int i, j, value;
-	int rows_to_add, cols_to_add;
-
-	/* check the row */
-	for (i = 0; i < game->board_size; i++) {
-		value = game->current[row][i].value;
-		game->current[row][i].value = DEFAULT;
-		if (value == DEFAULT || is_value_valid(game, row, i, value))
-			game->current[row][i].isError = 0;
-		else
-			game->current[row][i].isError = 1;
-		game->current[row][i].value = value;
-	}
-
-	/* check the column */
-	for (i = 0; i < game->board_size; i++) {
-		value = game->current[i][col].value;
-		game->current[i][col].value = DEFAULT;
-		if (value == DEFAULT || is_value_valid(game, i, col, value))
-			game->current[i][col].isError = 0;
-		else
-			game->current[i][col].isError = 1;
-		game->current[i][col].value = value;
-	}
-
-	/* check the block */
-	rows_to_add = (row / game->block_row) * game->block_row;
-	cols_to_add = (col / game->block_col) * game->block_col;
-
-	for (i = rows_to_add; i < rows_to_add + game->block_row; i++)
-		for (j = cols_to_add; j < cols_to_add + game->block_col; j++) {
-			value = game->current[i][j].value;
-			game->current[i][j].value = DEFAULT;
-			if (value == DEFAULT || is_value_valid(game, i, j, value))
-				game->current[i][j].isError = 0;
-			else
-				game->current[i][j].isError = 1;
-			game->current[i][j].value = value;
-		}
+int is_cell_error(Board* game, int row, int col) {
+	return game->kernels->is_error(game, CELL_INDEX(game, row, col));
 }
 
-void update_cell_options(Board* game, int row, int col) {
-	int i = 1;
-
-	while (game->current[row][col].options->length > 0) {
-		remove_option(&game->current[row][col],
-				game->current[row][col].options->top->value);
+void set_value(Board* game, int row, int col, int value) {
+	int cell = CELL_INDEX(game, row - 1, col - 1);
+	int old_value = game->cells[cell].value;
 
-		if (game->current[row][col].value != DEFAULT)
-			return;
-	}
-	for (; i <= game->board_size; i++) {
-		if (is_value_valid(game, row, col, i))
-			insert_option(&game->current[row][col], i);
-	}
+	if (old_value != DEFAULT)
+		game->hash ^= zobrist_key(cell, old_value);
+	if (value != DEFAULT)
+		game->hash ^= zobrist_key(cell, value);
+	game->kernels->set_cell(game, cell, value);
 }
 
-void update_options_after_set(Board* game, int row, int col) {
-	int i, j;
-	int rows_to_add, cols_to_add;
-
-	/* modify the row and column */
-	for (i = 0; i < game->board_size; i++) {
-		update_cell_options(game, row, i);
-		update_cell_options(game, i, col);
+/*
+ * Function: allocate_board
+ * ----------------------
+ * 	Allocates a board with {rows}x{cols} blocks as a single memory block, without initializing
+ * 	its cells and units. The block is cache aligned so boards of the same dimensions share
+ * 	the same layout.
+ */
+Board* allocate_board(int rows, int cols) {
+	int board_size = rows * cols;
+	int cells_count = board_size * board_size;
+	size_t sizes[4], aligns[4];
+	void* memory;
+	Board* board;
+	Arena arena;
+
+	sizes[0] = sizeof(Board);
+	aligns[0] = CACHE_LINE;
+	sizes[1] = sizeof(Cell) * cells_count;
+	aligns[1] = CACHE_LINE;
+	sizes[2] = sizeof(OptionsSet) * UNITS_PER_CELL * board_size;
+	aligns[2] = sizeof(unsigned long);
+	sizes[3] = sizeof(int) * UNITS_PER_CELL * cells_count;
+	aligns[3] = sizeof(int);
+
+	if ((memory = malloc(arena_size(4, sizes, aligns) + CACHE_LINE)) == NULL) {
+		printf(MALLOC_ERROR);
+		exit(0);
 	}
+	arena_init(&arena,
+			(char *) memory + CACHE_LINE
+					- (unsigned long) memory % CACHE_LINE,
+			arena_size(4, sizes, aligns));
 
-	/* modify the block */
-	rows_to_add = (row / game->block_row) * game->block_row;
-	cols_to_add = (col / game->block_col) * game->block_col;
+	board = (Board *) arena_alloc(&arena, sizes[0], aligns[0]);
+	board->memory = memory;
+	board->block_row = rows;
+	board->block_col = cols;
+	board->board_size = board_size;
+	board->hash = zobrist_shape_key(rows, cols);
 
-	for (i = rows_to_add; i < rows_to_add + game->block_row; i++)
-		for (j = cols_to_add; j < cols_to_add + game->block_col; j++) {
-			update_cell_options(game, i, j);
-		}
-}
+	board->cells = (Cell *) arena_alloc(&arena, sizes[1], aligns[1]);
+	board->units_used = (OptionsSet *) arena_alloc(&arena, sizes[2], aligns[2]);
+	board->units_count = (int *) arena_alloc(&arena, sizes[3], aligns[3]);
+	board->geometry = get_geometry(rows, cols);
+	board->kernels = select_kernels(rows, cols);
 
-void set_value(Board* game, int row, int col, int value) {
-	int prev_val = game->current[row - 1][col - 1].value;
-	if (value != prev_val) {
-		game->current[row - 1][col - 1].value = value;
-		check_specific_error(game, row - 1, col - 1);
-		update_options_after_set(game, row - 1, col - 1);
-	}
+	board->state_size = arena.memory + arena.used - (char *) board->cells;
+	return board;
 }
 
 Board* create_board(int rows, int cols) {
-	int i, j, k;
-	Board* board = (Board*) malloc(sizeof(Board));
-	Cell **current;
-	if (board == NULL) {
-		printf(MALLOC_ERROR);
-		exit(0);
-	}
-	board->block_row = rows;
-	board->block_col = cols;
-	board->board_size = rows * cols;
-
-	if ((current = (Cell **) malloc(sizeof(Cell *) * board->board_size)) == NULL) {
-		printf(MALLOC_ERROR);
-		exit(0);
-	}
-	board->current = current;
+	int i;
+	Board* board = allocate_board(rows, cols);
+	int cells_count = board->board_size * board->board_size;
 
-	for (i = 0; i < board->board_size; i++) {
-		if ((current[i] = (Cell *) malloc(sizeof(Cell) * board->board_size))
-				== NULL) {
-			printf(MALLOC_ERROR);
-			exit(0);
-		}
-		for (j = 0; j < board->board_size; j++) {
-			create_cell(&current[i][j]);
-			for (k = 1; k <= board->board_size; k++) {
-				insert_option(&current[i][j], k);
-			}
-		}
+	for (i = 0; i < cells_count; i++) {
+		create_cell(&board->cells[i]);
+		options_fill(&board->cells[i].options, board->board_size);
 	}
+	for (i = 0; i < board->geometry->units_count; i++)
+		options_clear(&board->units_used[i]);
+	memset(board->units_count, 0, sizeof(int) * UNITS_PER_CELL * cells_count);
 	return board;
 }
 
-Board* create_board_copy(Board* game) {
-	Board* newGame = create_board(game->block_row, game->block_col);
-	int row, col;
+void copy_board(Board* dest, Board* src) {
+	memcpy(dest->cells, src->cells, src->state_size);
+	dest->hash = src->hash;
+}
 
-	for (row = 0; row < game->board_size; row++) {
-		for (col = 0; col < game->board_size; col++) {
-			newGame->current[row][col].isError =
-					game->current[row][col].isError;
-			newGame->current[row][col].isFixed =
-					game->current[row][col].isFixed;
-			set_value(newGame, row + 1, col + 1, game->current[row][col].value);
-		}
-	}
+Board* create_board_copy(Board* game) {
+	Board* newGame = allocate_board(game->block_row, game->block_col);
+	copy_board(newGame, game);
 	return newGame;
 }
 
@@ -324,34 +212,18 @@ void create_cell(Cell* cell) {
 	cell->isFixed = 0;
 	cell->isError = 0;
 	cell->value = DEFAULT;
-	if ((cell->options = (OptionsList *) malloc(sizeof(OptionsList))) == NULL) {
-		printf(MALLOC_ERROR);
-		exit(0);
-	}
-	cell->options->length = 0;
+	options_clear(&cell->options);
 }
 
 void destroy_cell(Cell* cell) {
 	if (!cell)
 		return;
-	while (cell->options->length > 0) {
-		remove_option(cell, cell->options->top->value);
-	}
-	free(cell->options);
+	options_clear(&cell->options);
 }
 
 void destroy_board(Board* board) {
-	int i, j;
 	if (!board)
 		return;
-	for (i = board->board_size - 1; i >= 0; i--) {
-		for (j = board->board_size - 1; j >= 0; j--) {
-			destroy_cell(&board->current[i][j]);
-		}
-		if (board->current[i]) {
-			free(board->current[i]);
-		}
-	}
-	free(board->current);
-	free(board);
+	release_geometry(board->geometry);
+	free(board->memory);
 }
@@ -1,5 +1,11 @@
 #ifndef GAME_H_
 #define GAME_H_
+
+#include "options_set.h"
+#include "arena.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "zobrist.h"
 /*
  * game.h
  *
@@ -16,34 +22,6 @@ typedef enum game_mode {
 
 extern game_mode current_game_mode;
 extern int mark_errors;
-/*
- * Structure: OptionNode
- * ------------------
- * 	A structure used to represent a node in the options linked list
- *
- * 	value : an integer representing an option for the cell
- * 	next : a pointer to the next element in the list
- * 	prev : a pointer to the previous element in the list
- */
-typedef struct option_node {
-	int value;
-	struct option_node* next;
-	struct option_node* prev;
-} OptionNode;
-
-/*
- * Structure: OptionsList
- * ------------------
- * 	A structure used to represent a linked list
- *
- * 	top : a pointer to the first element of the list
- * 	length : an integer representing the length of the list
- */
-typedef struct {
-	OptionNode* top;
-	int length;
-} OptionsList;
-
 /*
  * Structure: Cell
  * ------------------
@@ -52,15 +30,20 @@ typedef struct {
  * 	isFixed : an integer representing whether this cell is fixed in the user's board.
  * 	isError : an integer representing whether this cell is an error in the user's board.
  * 	value : an integer representing the cell's value
- * 	options : a linked list storing the value options of a cell.
+ * 	options : a bitset storing the value options of a cell.
  */
 typedef struct {
 	int isFixed;
 	int isError;
 	int value;
-	OptionsList* options;
+	OptionsSet options;
 } Cell;
 
+/*
+ * The alignment of the cells array, the size of a cache line.
+ */
+#define CACHE_LINE 64
+
 /*
  * Structure: Board
  * ------------------
@@ -69,26 +52,56 @@ typedef struct {
  * 	block_row : an integer representing how many rows every block have.
  * 	block_col : an integer representing how many columns every block have.
  * 	board_size : an integer representing how many rows and columns the board have.
- * 	mark_errors : an integer representing the mark errors option.
- * 	current[] : an Cells array representing the current board's state.
- */
-typedef struct {
+ * 	memory : the single allocated memory block holding the board and all its arrays.
+ * 	state_size : the size in bytes of the part of the block holding the board state, from the
+ * 			beginning of the cells array to the end of the block.
+ * 	cells : a cache aligned Cells array of board_size * board_size cells, row after row.
+ * 	geometry : the shared description of the board's shape, its units and peers.
+ * 	kernels : the routines used on every move, specialized for the board's shape when possible.
+ * 	units_used : for every unit of the geometry, the set of values present in it.
+ * 	units_count : for every unit and value, the amount of cells of the unit holding the value,
+ * 			at index (unit * board_size + value - 1).
+ * 	hash : the Zobrist hash of the board's values (see zobrist.h), kept up to date by set_value.
+ * 			Boards with the same shape and values have the same hash.
+ */
+typedef struct board {
 	int block_row;
 	int block_col;
 	int board_size;
-	Cell **current;
+	void *memory;
+	size_t state_size;
+	Cell *cells;
+	Geometry *geometry;
+	const Kernels *kernels;
+	OptionsSet *units_used;
+	int *units_count;
+	unsigned long hash;
 } Board;
 
+/*
+ * Macro: CELL_INDEX
+ * ----------------------
+ * 	Returns the linear index in the cells array of the cell at (row, col), counting from 0.
+ */
+#define CELL_INDEX(game, row, col) ((row) * (game)->board_size + (col))
+
+/*
+ * Macro: GET_CELL
+ * ----------------------
+ * 	Returns a pointer to the cell at (row, col) of the board, counting from 0.
+ */
+#define GET_CELL(game, row, col) (&(game)->cells[CELL_INDEX(game, row, col)])
+
 /*
  * Function: insert_option
  * ----------------------
  * 	Receives a Cell and an integer representing a value.
- * 	It inserts that value to the Cell's options list.
+ * 	It inserts that value to the Cell's options set.
  *
- * 	cell : a Cell which his options array should be changed.
- * 	value : an integer representing the value to be added to the Cell's options array.
+ * 	cell : a Cell which his options set should be changed.
+ * 	value : an integer representing the value to be added to the Cell's options set.
  *
- * 	returns: ?
+ * 	returns: 1 if the value was added, 0 if it was already an option.
  */
 int insert_option(Cell* cell, int value);
 
@@ -96,12 +109,12 @@ int insert_option(Cell* cell, int value);
  * Function: remove_option
  * ----------------------
  * 	Receives a Cell and an integer representing a value.
- * 	It removes that value from the Cell's options list.
+ * 	It removes that value from the Cell's options set.
  *
- * 	cell : a Cell which his options array should be changed.
- * 	value : an integer representing the value to be removed from the Cell's options list.
+ * 	cell : a Cell which his options set should be changed.
+ * 	value : an integer representing the value to be removed from the Cell's options set.
  *
- * 	returns: ?
+ * 	returns: 1 if the value was removed, 0 if it wasn't an option.
  */
 int remove_option(Cell* cell, int value);
 
@@ -132,51 +145,26 @@ void print_board(Board* board);
 int is_value_valid(Board* game, int row, int col, int value);
 
 /*
- * Function: check_specific_error
- * ----------------------
- * 	Receives a Board, and two integers indicating the cell's row and column, and check only the related cells for errors.
- *
- * 	game : the Board which holds the current board.
- * 	row : an integer indicating in which row the cell is located.
- * 	col : an integer indicating in which column the cell is located.
- *
- * 	returns: ?
- */
-void check_specific_error(Board* game, int row, int col);
-
-/*
- * Function: update_cell_options
- * ----------------------
- * 	Receives a Board, and two integers representing row number, column number.
- * 	It modifies options lists for it.
- *
- * 	game : the Board which holds the current board.
- * 	row : an integer representing the row coordinate of a cell.
- * 	col : an integer representing the column coordinate of a cell.
- *
- * 	returns: ?
- */
-void update_cell_options(Board* game, int row, int col);
-
-/*
- * Function: update_options_after_set
+ * Function: is_cell_error
  * ----------------------
  * 	Receives a Board, and two integers representing row number, column number.
- * 	It modifies options lists only for the affected cells.
+ * 	It checks if the value of the cell at coordinates (row, col) appears in another cell of its
+ * 	row, column or block, using the values counts of its units.
  *
  * 	game : the Board which holds the current board.
  * 	row : an integer representing the row coordinate of a cell.
  * 	col : an integer representing the column coordinate of a cell.
  *
- * 	returns: ?
+ * 	returns: 1 if the cell is an error, 0 otherwise.
  */
-void update_options_after_set(Board* game, int row, int col);
+int is_cell_error(Board* game, int row, int col);
 
 /*
  * Function: set_value
  * ----------------------
  * 	Receives a Board, and three integers representing row number, column number, value.
- * 	It assigns the value to the cell, mark errors, and modifying options lists.
+ * 	It assigns the value to the cell, mark errors, and modifying options lists, and updates the hash
+ * 	of the board.
  *
  * 	game : the Board which holds the current board.
  * 	row : an integer representing the row coordinate of a cell.
@@ -203,7 +191,7 @@ Board* create_board(int rows, int cols);
 /*
  * Function: create_board_copy
  * ----------------------
- * 	Receives a board and returns a deep copy of it.
+ * 	Receives a board and returns a deep copy of it, made by copying its state with copy_board.
  *
  *	game : the board of the game.
  *
@@ -211,6 +199,17 @@ Board* create_board(int rows, int cols);
  */
 Board* create_board_copy(Board* game);
 
+/*
+ * Function: copy_board
+ * ----------------------
+ * 	Receives two boards of the same blocks dimensions, and copies the whole state of one
+ * 	(cells, errors, options and units) to the other with a single memcpy.
+ *
+ *	dest : the board to copy to.
+ *	src : the board to copy from.
+ */
+void copy_board(Board* dest, Board* src);
+
 /*
  * Function: create_cell
  * ----------------------
@@ -236,7 +235,7 @@ void destroy_cell(Cell* cell);
 /*
  * Function: destroy_board
  * ------------------------
- * 	Used to destroy a command structure and free the memory allocated to it.
+ * 	Used to destroy a board structure and free the memory allocated to it.
  *
  * 	board : a pointer to the Board structure.
  *
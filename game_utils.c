@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
 #include "game_utils.h"
 
 #define FOPEN_ERROR "Error: could not open file.\n"
@@ -15,8 +16,8 @@ int save_board(Board* board, const char* path, int all_fixed) {
 	fprintf(file, "%d %d\n", board->block_row, board->block_col);
 	for (i = 0; i < board->board_size; i++) {
 		for (j = 0; j < board->board_size; j++) {
-			val = board->current[i][j].value;
-			fixed = ((board->current[i][j].isFixed || all_fixed) && val) ?
+			val = GET_CELL(board, i, j)->value;
+			fixed = ((GET_CELL(board, i, j)->isFixed || all_fixed) && val) ?
 					"." : "";
 			space = (j == board->board_size - 1) ? "" : " ";
 			fprintf(file, "%d%s%s", val, fixed, space);
@@ -36,17 +37,29 @@ Board* load_board(char* path) {
 	if (file == NULL) {
 		return NULL;
 	}
-	fscanf(file, "%d", &block_row);
-	fscanf(file, "%d", &block_col);
+	if (fscanf(file, "%d", &block_row) != 1
+			|| fscanf(file, "%d", &block_col) != 1 || block_row < 1
+			|| block_col < 1 || block_row * block_col > OPTIONS_MAX_VALUE) {
+		fclose(file);
+		return NULL;
+	}
 	board = create_board(block_row, block_col);
 	for (i = 0; i < board->board_size; i++) {
 		for (j = 0; j < board->board_size; j++) {
-			fscanf(file, "%d", &val);
+			/* a value is a number in 0..board_size, followed by a dot, a space or the end of the file */
+			dot = ' ';
+			if (fscanf(file, "%d", &val) != 1 || val < 0
+					|| val > board->board_size
+					|| (fscanf(file, "%c", &dot) == 1 && dot != '.'
+							&& !isspace((unsigned char) dot))) {
+				destroy_board(board);
+				fclose(file);
+				return NULL;
+			}
 			set_value(board, i + 1, j + 1, val);
-			fscanf(file, "%c", &dot);
 			is_fixed = dot == '.' ? 1 : 0;
 			if (is_fixed) {
-				board->current[i][j].isFixed = 1;
+				GET_CELL(board, i, j)->isFixed = 1;
 			}
 		}
 	}
@@ -22,6 +22,7 @@ int save_board(Board* board, const char* path, int all_fixed);
  *
  * 	path : the location of the file which contains the board.
  *
- * 	returns: a pointer to the loaded board, NULL if an error occurred.
+ * 	returns: a pointer to the loaded board, NULL if an error occurred, the board is bigger than
+ * 			 OPTIONS_MAX_VALUE, or the file has a value that isn't a number in 0..board_size.
  */
 Board* load_board(char* path);
@@ -0,0 +1,139 @@
+/*
+ * geometry.c
+ */
+
+#include <stdlib.h>
+#include "geometry.h"
+#include "arena.h"
+
+Geometry* geometries = NULL;
+
+/*
+ * Function: build_units
+ * ----------------------
+ * 	Fills the cells of every unit and the units of every cell.
+ */
+void build_units(Geometry* geometry) {
+	int i, j, row, col, block, n = geometry->board_size;
+
+	for (row = 0; row < n; row++)
+		for (col = 0; col < n; col++) {
+			block = row / geometry->block_row * geometry->block_row
+					+ col / geometry->block_col;
+			i = row * n + col;
+			geometry->cell_units[i * UNITS_PER_CELL] = row;
+			geometry->cell_units[i * UNITS_PER_CELL + 1] = n + col;
+			geometry->cell_units[i * UNITS_PER_CELL + 2] = 2 * n + block;
+
+			geometry->units[row * n + col] = i;
+			geometry->units[(n + col) * n + row] = i;
+			j = (row % geometry->block_row) * geometry->block_col
+					+ col % geometry->block_col;
+			geometry->units[(2 * n + block) * n + j] = i;
+		}
+}
+
+/*
+ * Function: compute_peer
+ * ----------------------
+ * 	Computes the i-th peer of a cell: its row first, then its column, then the cells of its
+ * 	block which are in neither.
+ */
+int compute_peer(Geometry* geometry, int cell, int i) {
+	int n = geometry->board_size, row = cell / n, col = cell % n;
+	int block_row = geometry->block_row, block_col = geometry->block_col;
+	int first_row = row - row % block_row, first_col = col - col % block_col;
+	int peer_row, peer_col;
+
+	if (i < n - 1)
+		return row * n + (i < col ? i : i + 1);
+	i -= n - 1;
+	if (i < n - 1)
+		return (i < row ? i : i + 1) * n + col;
+	i -= n - 1;
+	peer_row = i / (block_col - 1);
+	peer_col = i % (block_col - 1);
+	peer_row += (peer_row < row % block_row) ? 0 : 1;
+	peer_col += (peer_col < col % block_col) ? 0 : 1;
+	return (first_row + peer_row) * n + first_col + peer_col;
+}
+
+/*
+ * Function: build_peers
+ * ----------------------
+ * 	Fills the peers table of every cell.
+ */
+void build_peers(Geometry* geometry) {
+	int i, cell;
+	int* peers = geometry->peers;
+
+	for (cell = 0; cell < geometry->cells_count; cell++)
+		for (i = 0; i < geometry->peers_count; i++)
+			*peers++ = compute_peer(geometry, cell, i);
+}
+
+Geometry* get_geometry(int block_row, int block_col) {
+	Geometry* geometry;
+	int n = block_row * block_col;
+
+	for (geometry = geometries; geometry; geometry = geometry->next)
+		if (geometry->block_row == block_row
+				&& geometry->block_col == block_col) {
+			geometry->refs += 1;
+			return geometry;
+		}
+
+	geometry = (Geometry*) safe_malloc(sizeof(Geometry));
+	geometry->block_row = block_row;
+	geometry->block_col = block_col;
+	geometry->board_size = n;
+	geometry->cells_count = n * n;
+	geometry->units_count = UNITS_PER_CELL * n;
+	geometry->peers_count = 2 * (n - 1) + (block_row - 1) * (block_col - 1);
+	geometry->cell_units = (int*) safe_malloc(
+			sizeof(int) * UNITS_PER_CELL * n * n);
+	geometry->units = (int*) safe_malloc(sizeof(int) * UNITS_PER_CELL * n * n);
+	build_units(geometry);
+	if (n <= LARGE_BOARD_SIZE) {
+		geometry->peers = (int*) safe_malloc(
+				sizeof(int) * geometry->peers_count * n * n);
+		build_peers(geometry);
+	} else {
+		geometry->peers = NULL;
+	}
+
+	geometry->refs = 1;
+	geometry->next = geometries;
+	geometries = geometry;
+	return geometry;
+}
+
+void release_geometry(Geometry* geometry) {
+	Geometry** link = &geometries;
+
+	if (!geometry || --geometry->refs > 0)
+		return;
+	while (*link != geometry)
+		link = &(*link)->next;
+	*link = geometry->next;
+	free(geometry->cell_units);
+	free(geometry->units);
+	free(geometry->peers);
+	free(geometry);
+}
+
+int* cell_peers(Geometry* geometry, int cell) {
+	if (!geometry->peers)
+		return NULL;
+	return geometry->peers + cell * geometry->peers_count;
+}
+
+int get_peer(Geometry* geometry, int cell, int i) {
+	if (geometry->peers)
+		return geometry->peers[cell * geometry->peers_count + i];
+	return compute_peer(geometry, cell, i);
+}
+
+int* unit_cells(Geometry* geometry, int unit) {
+	return geometry->units + unit * geometry->board_size;
+}
@@ -0,0 +1,105 @@
+/*
+ * geometry.h
+ */
+
+#ifndef GEOMETRY_H_
+#define GEOMETRY_H_
+
+/*
+ * The amount of units (row, column and block) every cell belongs to.
+ */
+#define UNITS_PER_CELL 3
+
+/*
+ * The largest board size that is not a large board. Large boards (up to 100x100) don't keep
+ * a peers table, since it would grow like board_size^3, and compute their peers on the fly.
+ */
+#define LARGE_BOARD_SIZE 36
+
+/*
+ * Structure: Geometry
+ * ------------------
+ * 	A structure used to describe the shape of a board, built once for every blocks dimensions
+ * 	and shared by all the boards of that shape. Cells are identified by their linear index
+ * 	(row * board_size + col). Units are numbered rows first, then columns, then blocks, so unit u
+ * 	is row u, column u - board_size or block u - 2 * board_size.
+ *
+ * 	block_row : an integer representing how many rows every block have.
+ * 	block_col : an integer representing how many columns every block have.
+ * 	board_size : an integer representing how many rows and columns the board have.
+ * 	cells_count : an integer representing the amount of cells in the board.
+ * 	units_count : an integer representing the amount of units in the board.
+ * 	peers_count : an integer representing the amount of peers of every cell.
+ * 	cell_units : for every cell, the UNITS_PER_CELL units it belongs to (row, column, block).
+ * 	units : for every unit, the board_size cells in it.
+ * 	peers : for every cell, the peers_count other cells sharing a unit with it, each listed once.
+ * 			NULL for large boards.
+ * 	refs : the amount of boards using the geometry.
+ * 	next : a pointer to the next geometry in the shared geometries list.
+ */
+typedef struct geometry {
+	int block_row;
+	int block_col;
+	int board_size;
+	int cells_count;
+	int units_count;
+	int peers_count;
+	int* cell_units;
+	int* units;
+	int* peers;
+	int refs;
+	struct geometry* next;
+} Geometry;
+
+/*
+ * Function: get_geometry
+ * ----------------------
+ * 	Receives the blocks dimensions and returns the shared geometry of that shape, building
+ * 	it on first use. Every call should be matched by a call to release_geometry.
+ *
+ * 	block_row : an integer representing how many rows every block have.
+ * 	block_col : an integer representing how many columns every block have.
+ *
+ * 	returns: a pointer to the geometry.
+ */
+Geometry* get_geometry(int block_row, int block_col);
+
+/*
+ * Function: release_geometry
+ * ----------------------
+ * 	Receives a geometry returned by get_geometry and releases it, the geometry is destroyed when
+ * 	no board uses it.
+ *
+ * 	geometry : the geometry to release.
+ */
+void release_geometry(Geometry* geometry);
+
+/*
+ * Function: cell_peers
+ * ----------------------
+ * 	Receives a geometry and a cell index and returns the list of the cell's peers.
+ *
+ * 	returns: a pointer to the first of the cell's peers_count peers, or NULL for large boards.
+ */
+int* cell_peers(Geometry* geometry, int cell);
+
+/*
+ * Function: get_peer
+ * ----------------------
+ * 	Receives a geometry, a cell index and an integer i, and returns the i-th peer of the cell,
+ * 	from the peers table or computed for large boards.
+ *
+ * 	returns: the index of the peer.
+ */
+int get_peer(Geometry* geometry, int cell, int i);
+
+/*
+ * Function: unit_cells
+ * ----------------------
+ * 	Receives a geometry and a unit index and returns the list of the unit's cells.
+ *
+ * 	returns: a pointer to the first of the unit's board_size cells.
+ */
+int* unit_cells(Geometry* geometry, int unit);
+
+#endif /* GEOMETRY_H_ */
@@ -0,0 +1,80 @@
+/*
+ * kernels.c
+ */
+
+#include "game.h"
+#include "kernels.h"
+
+#define DEFAULT 0
+
+/* generic kernels, for any board shape */
+#define KERNEL(name) name##_generic
+#define KERNEL_BOARD_SIZE (game->board_size)
+#define KERNEL_PEERS (game->geometry->peers_count)
+#define KERNEL_SINGLE_WORD 0
+#include "kernels_template.h"
+#undef KERNEL
+#undef KERNEL_BOARD_SIZE
+#undef KERNEL_PEERS
+#undef KERNEL_SINGLE_WORD
+
+/*
+ * Specialized kernels of a board with {r}x{c} blocks, its size and peers amount are
+ * constants and its values fit in a single word.
+ */
+#define KERNEL_SINGLE_WORD 1
+
+#define KERNEL(name) name##_2x3
+#define KERNEL_BOARD_SIZE 6
+#define KERNEL_PEERS 12
+#include "kernels_template.h"
+#undef KERNEL
+#undef KERNEL_BOARD_SIZE
+#undef KERNEL_PEERS
+
+#define KERNEL(name) name##_3x3
+#define KERNEL_BOARD_SIZE 9
+#define KERNEL_PEERS 20
+#include "kernels_template.h"
+#undef KERNEL
+#undef KERNEL_BOARD_SIZE
+#undef KERNEL_PEERS
+
+#define KERNEL(name) name##_4x4
+#define KERNEL_BOARD_SIZE 16
+#define KERNEL_PEERS 39
+#include "kernels_template.h"
+#undef KERNEL
+#undef KERNEL_BOARD_SIZE
+#undef KERNEL_PEERS
+
+#define KERNEL(name) name##_5x5
+#define KERNEL_BOARD_SIZE 25
+#define KERNEL_PEERS 64
+#include "kernels_template.h"
+#undef KERNEL
+#undef KERNEL_BOARD_SIZE
+#undef KERNEL_PEERS
+
+#undef KERNEL_SINGLE_WORD
+
+#define KERNELS_TABLE(suffix) { is_value_valid_##suffix, is_error_##suffix, \
+	set_cell_##suffix, missing_options_##suffix }
+
+const Kernels generic_kernels = KERNELS_TABLE(generic);
+const Kernels kernels_2x3 = KERNELS_TABLE(2x3);
+const Kernels kernels_3x3 = KERNELS_TABLE(3x3);
+const Kernels kernels_4x4 = KERNELS_TABLE(4x4);
+const Kernels kernels_5x5 = KERNELS_TABLE(5x5);
+
+const Kernels* select_kernels(int block_row, int block_col) {
+	if (block_row == 2 && block_col == 3)
+		return &kernels_2x3;
+	if (block_row == 3 && block_col == 3)
+		return &kernels_3x3;
+	if (block_row == 4 && block_col == 4)
+		return &kernels_4x4;
+	if (block_row == 5 && block_col == 5)
+		return &kernels_5x5;
+	return &generic_kernels;
+}
@@ -0,0 +1,46 @@
+/*
+ * kernels.h
+ */
+
+#ifndef KERNELS_H_
+#define KERNELS_H_
+
+#include "options_set.h"
+
+struct board;
+
+/*
+ * Structure: Kernels
+ * ------------------
+ * 	A structure holding the board routines that run on every move. Every common board shape
+ * 	has its own version of them, compiled with the shape's dimensions as constants, and all
+ * 	other shapes use the generic version. Cells are identified by their linear index.
+ *
+ * 	is_value_valid : returns 1 if value is not used in any unit of the cell, 0 otherwise.
+ * 	is_error : returns 1 if the cell's value appears in another cell of its units, 0 otherwise.
+ * 	set_cell : assigns value to the cell, updating the units, and the errors and options of its
+ * 			peers by the change of value only.
+ * 	missing_options : fills options with the values 1..board_size missing from the three sets
+ * 			of used values, the options of a cell given the used values of its units.
+ */
+typedef struct {
+	int (*is_value_valid)(struct board* game, int cell, int value);
+	int (*is_error)(struct board* game, int cell);
+	void (*set_cell)(struct board* game, int cell, int value);
+	void (*missing_options)(OptionsSet* options, OptionsSet* first,
+			OptionsSet* second, OptionsSet* third, int board_size);
+} Kernels;
+
+/*
+ * Function: select_kernels
+ * ----------------------
+ * 	Receives the blocks dimensions and returns the kernels for boards of that shape.
+ *
+ * 	block_row : an integer representing how many rows every block have.
+ * 	block_col : an integer representing how many columns every block have.
+ *
+ * 	returns: the specialized kernels of the shape if there are any, the generic kernels otherwise.
+ */
+const Kernels* select_kernels(int block_row, int block_col);
+
+#endif /* KERNELS_H_ */
@@ -0,0 +1,126 @@
+/*
+ * kernels_template.h
+ *
+ * The body of a set of kernels, included by kernels.c once for every board shape.
+ * Before including it define:
+ * 	KERNEL(name) : the name of a kernel of this set.
+ * 	KERNEL_BOARD_SIZE : the board size, a constant or an expression of game.
+ * 	KERNEL_PEERS : the amount of peers of a cell, a constant or an expression of game.
+ * 	KERNEL_SINGLE_WORD : 1 if the values of the board fit in the first word of an OptionsSet.
+ */
+
+int KERNEL(is_value_valid)(Board* game, int cell, int value) {
+	int* units = &game->geometry->cell_units[cell * UNITS_PER_CELL];
+#if KERNEL_SINGLE_WORD
+	unsigned long used = game->units_used[units[0]].words[0]
+			| game->units_used[units[1]].words[0]
+			| game->units_used[units[2]].words[0];
+
+	return !((used >> (value - 1)) & 1UL);
+#else
+	int word = (value - 1) / OPTIONS_WORD_BITS;
+	unsigned long used = game->units_used[units[0]].words[word]
+			| game->units_used[units[1]].words[word]
+			| game->units_used[units[2]].words[word];
+
+	return !((used >> ((value - 1) % OPTIONS_WORD_BITS)) & 1UL);
+#endif
+}
+
+int KERNEL(is_error)(Board* game, int cell) {
+	int value = game->cells[cell].value;
+	int* units = &game->geometry->cell_units[cell * UNITS_PER_CELL];
+
+	if (value == DEFAULT)
+		return 0;
+	return game->units_count[units[0] * KERNEL_BOARD_SIZE + value - 1] > 1
+			|| game->units_count[units[1] * KERNEL_BOARD_SIZE + value - 1] > 1
+			|| game->units_count[units[2] * KERNEL_BOARD_SIZE + value - 1] > 1;
+}
+
+void KERNEL(missing_options)(OptionsSet* options, OptionsSet* first,
+		OptionsSet* second, OptionsSet* third, int board_size) {
+#if KERNEL_SINGLE_WORD
+	unsigned int i;
+
+	(void) board_size;
+	options->words[0] = ~(first->words[0] | second->words[0] | third->words[0])
+			& ((1UL << (KERNEL_BOARD_SIZE - 1) << 1) - 1);
+	for (i = 1; i < OPTIONS_WORDS; i++)
+		options->words[i] = 0;
+	options->length = options_popcount(options->words[0]);
+#else
+	options_fill_missing(options, first, second, third, board_size);
+#endif
+}
+
+void KERNEL(update_options)(Board* game, int cell) {
+	int* units = &game->geometry->cell_units[cell * UNITS_PER_CELL];
+	OptionsSet* options = &game->cells[cell].options;
+
+	if (game->cells[cell].value != DEFAULT) {
+		options_clear(options);
+		return;
+	}
+	KERNEL(missing_options)(options, &game->units_used[units[0]],
+			&game->units_used[units[1]], &game->units_used[units[2]],
+			game->board_size);
+}
+
+/*
+ * Applies to a peer the change of a cell of its units from the value removed to the value added
+ * (DEFAULT for none): the added value is no longer an option of the peer, and the removed value
+ * is an option again unless another cell of the peer's units holds it. Only peers holding one of
+ * the two values can change their error mark.
+ */
+void KERNEL(apply_delta)(Board* game, int peer, int removed, int added) {
+	Cell* cell = &game->cells[peer];
+
+	if (cell->value != DEFAULT) {
+		if (cell->value == removed || cell->value == added)
+			cell->isError = KERNEL(is_error)(game, peer);
+		return;
+	}
+	if (added != DEFAULT)
+		options_remove(&cell->options, added);
+	if (removed != DEFAULT && KERNEL(is_value_valid)(game, peer, removed))
+		options_insert(&cell->options, removed);
+}
+
+void KERNEL(set_cell)(Board* game, int cell, int value) {
+	int i, unit;
+	int prev_val = game->cells[cell].value;
+	int* units = &game->geometry->cell_units[cell * UNITS_PER_CELL];
+#if KERNEL_SINGLE_WORD
+	int* peers = cell_peers(game->geometry, cell);
+#endif
+
+	if (value == prev_val)
+		return;
+	for (i = 0; i < UNITS_PER_CELL; i++) {
+		unit = units[i];
+		if (prev_val != DEFAULT
+				&& --game->units_count[unit * KERNEL_BOARD_SIZE + prev_val - 1]
+						== 0)
+			options_remove(&game->units_used[unit], prev_val);
+		if (value != DEFAULT) {
+			game->units_count[unit * KERNEL_BOARD_SIZE + value - 1] += 1;
+			options_insert(&game->units_used[unit], value);
+		}
+	}
+	game->cells[cell].value = value;
+	game->cells[cell].isError = KERNEL(is_error)(game, cell);
+	KERNEL(update_options)(game, cell);
+
+#if KERNEL_SINGLE_WORD
+#if defined(__GNUC__) && __GNUC__ >= 8
+#pragma GCC unroll 64
+#endif
+	for (i = 0; i < KERNEL_PEERS; i++)
+		KERNEL(apply_delta)(game, peers[i], prev_val, value);
+#else
+	for (i = 0; i < KERNEL_PEERS; i++)
+		KERNEL(apply_delta)(game, get_peer(game->geometry, cell, i), prev_val,
+				value);
+#endif
+}
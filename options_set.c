@@ -0,0 +1,139 @@
+/*
+ * options_set.c
+ */
+
+#include <string.h>
+#include "options_set.h"
+
+/*
+ * Function: lowest_bit
+ * ----------------------
+ * 	Receives a non zero word and returns the index of its lowest set bit.
+ */
+int lowest_bit(unsigned long word) {
+#if defined(__GNUC__)
+	return __builtin_ctzl(word);
+#else
+	int i = 0;
+	while (!(word & 1UL)) {
+		word >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+int options_popcount(unsigned long word) {
+#if defined(__GNUC__)
+	return __builtin_popcountl(word);
+#else
+	int count = 0;
+	while (word) {
+		word &= word - 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+void options_clear(OptionsSet* set) {
+	memset(set->words, 0, sizeof(set->words));
+	set->length = 0;
+}
+
+void options_fill(OptionsSet* set, int max_value) {
+	int i, full = max_value / OPTIONS_WORD_BITS;
+	int rest = max_value % OPTIONS_WORD_BITS;
+
+	options_clear(set);
+	for (i = 0; i < full; i++)
+		set->words[i] = ~0UL;
+	if (rest)
+		set->words[full] = (1UL << rest) - 1;
+	set->length = max_value;
+}
+
+void options_fill_missing(OptionsSet* set, OptionsSet* first,
+		OptionsSet* second, OptionsSet* third, int max_value) {
+	unsigned int i;
+
+	options_fill(set, max_value);
+	set->length = 0;
+	for (i = 0; i < OPTIONS_WORDS; i++) {
+		set->words[i] &= ~(first->words[i] | second->words[i] | third->words[i]);
+		set->length += options_popcount(set->words[i]);
+	}
+}
+
+int options_contains(OptionsSet* set, int value) {
+	value -= 1;
+	return (set->words[value / OPTIONS_WORD_BITS]
+			>> (value % OPTIONS_WORD_BITS)) & 1UL;
+}
+
+int options_insert(OptionsSet* set, int value) {
+	unsigned long bit = 1UL << ((value - 1) % OPTIONS_WORD_BITS);
+	unsigned long* word = &set->words[(value - 1) / OPTIONS_WORD_BITS];
+
+	if (*word & bit)
+		return 0;
+	*word |= bit;
+	set->length += 1;
+	return 1;
+}
+
+int options_remove(OptionsSet* set, int value) {
+	unsigned long bit = 1UL << ((value - 1) % OPTIONS_WORD_BITS);
+	unsigned long* word = &set->words[(value - 1) / OPTIONS_WORD_BITS];
+
+	if (!(*word & bit))
+		return 0;
+	*word &= ~bit;
+	set->length -= 1;
+	return 1;
+}
+
+int options_select(OptionsSet* set, int n) {
+	unsigned int i, shift;
+	int count;
+	unsigned long word;
+
+	if (n < 0 || n >= set->length)
+		return 0;
+
+	for (i = 0; i < OPTIONS_WORDS; i++) {
+		count = options_popcount(set->words[i]);
+		if (n < count)
+			break;
+		n -= count;
+	}
+
+	/* skip whole bytes, then the lower bits of the right byte */
+	word = set->words[i];
+	for (shift = 0; shift < OPTIONS_WORD_BITS; shift += CHAR_BIT) {
+		count = options_popcount((word >> shift) & UCHAR_MAX);
+		if (n < count)
+			break;
+		n -= count;
+	}
+	word >>= shift;
+	for (; n > 0; n--)
+		word &= word - 1;
+
+	return i * OPTIONS_WORD_BITS + shift + lowest_bit(word) + 1;
+}
+
+int options_next(OptionsSet* set, int value) {
+	unsigned int i = value / OPTIONS_WORD_BITS;
+	unsigned long word;
+
+	if (i >= OPTIONS_WORDS)
+		return 0;
+	word = set->words[i] & (~0UL << (value % OPTIONS_WORD_BITS));
+	while (!word) {
+		if (++i >= OPTIONS_WORDS)
+			return 0;
+		word = set->words[i];
+	}
+	return i * OPTIONS_WORD_BITS + lowest_bit(word) + 1;
+}
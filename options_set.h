@@ -0,0 +1,123 @@
+/*
+ * options_set.h
+ */
+
+#ifndef OPTIONS_SET_H_
+#define OPTIONS_SET_H_
+
+#include <limits.h>
+
+/*
+ * The largest value a cell can hold (a 10x10 blocks board).
+ */
+#define OPTIONS_MAX_VALUE 100
+
+/*
+ * The amount of bits in a single word of the set.
+ */
+#define OPTIONS_WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+
+/*
+ * The amount of words needed to hold OPTIONS_MAX_VALUE bits.
+ */
+#define OPTIONS_WORDS ((OPTIONS_MAX_VALUE + OPTIONS_WORD_BITS - 1) / OPTIONS_WORD_BITS)
+
+/*
+ * Structure: OptionsSet
+ * ------------------
+ * 	A structure used to represent a set of values as a bitset. value v is stored in bit (v - 1).
+ *
+ * 	words : the bits of the set, least significant word first.
+ * 	length : an integer representing the amount of values in the set.
+ */
+typedef struct {
+	unsigned long words[OPTIONS_WORDS];
+	int length;
+} OptionsSet;
+
+/*
+ * Function: options_clear
+ * ----------------------
+ * 	Receives a set and removes all the values from it.
+ *
+ * 	set : the set to be cleared.
+ */
+void options_clear(OptionsSet* set);
+
+/*
+ * Function: options_fill
+ * ----------------------
+ * 	Receives a set and an integer, and fills the set with all the values 1..max_value.
+ *
+ * 	set : the set to be filled.
+ * 	max_value : the largest value to put in the set.
+ */
+void options_fill(OptionsSet* set, int max_value);
+
+/*
+ * Function: options_contains
+ * ----------------------
+ * 	Receives a set and a value and checks if the value is in the set.
+ *
+ * 	returns: 1 if the value is in the set, 0 otherwise.
+ */
+int options_contains(OptionsSet* set, int value);
+
+/*
+ * Function: options_insert
+ * ----------------------
+ * 	Receives a set and a value and inserts the value to the set.
+ *
+ * 	returns: 1 if the value was added, 0 if it was already in the set.
+ */
+int options_insert(OptionsSet* set, int value);
+
+/*
+ * Function: options_remove
+ * ----------------------
+ * 	Receives a set and a value and removes the value from the set.
+ *
+ * 	returns: 1 if the value was removed, 0 if it wasn't in the set.
+ */
+int options_remove(OptionsSet* set, int value);
+
+/*
+ * Function: options_select
+ * ----------------------
+ * 	Receives a set and an index n, and returns the n-th smallest value in the set (starting from 0).
+ *
+ * 	returns: the selected value, or 0 if the set has n values or less.
+ */
+int options_select(OptionsSet* set, int n);
+
+/*
+ * Function: options_next
+ * ----------------------
+ * 	Receives a set and a value, and returns the smallest value in the set which is bigger than it.
+ * 	Used to iterate over the set: for (v = options_next(set, 0); v; v = options_next(set, v))
+ *
+ * 	returns: the next value, or 0 if there is none.
+ */
+int options_next(OptionsSet* set, int value);
+
+/*
+ * Function: options_fill_missing
+ * ----------------------
+ * 	Receives a set, three sets and an integer, and fills the set with all the values 1..max_value
+ * 	that are not in any of the three sets.
+ *
+ * 	set : the set to be filled.
+ * 	first, second, third : the sets of the values to leave out.
+ * 	max_value : the largest value to put in the set.
+ */
+void options_fill_missing(OptionsSet* set, OptionsSet* first,
+		OptionsSet* second, OptionsSet* third, int max_value);
+
+/*
+ * Function: options_popcount
+ * ----------------------
+ * 	Receives a word and returns the amount of set bits in it.
+ */
+int options_popcount(unsigned long word);
+
+#endif /* OPTIONS_SET_H_ */
@@ -0,0 +1,249 @@
+/*
+ * parallel.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "parallel.h"
+#include "dlx.h"
+
+#define MALLOC_ERROR "Error: malloc has failed\n"
+#define THREAD_ERROR "Error: failed to create a thread\n"
+
+/*
+ * The amount of subtrees to split the search into for every thread, more subtrees balance the
+ * threads better but cost more to split.
+ */
+#define TASKS_PER_THREAD 16
+
+/*
+ * Structure: Tasks
+ * ------------------
+ * 	The subtrees of a split search. A subtree is given by the row nodes selected on the way to it,
+ * 	which are the same in every matrix built from the board.
+ *
+ * 	nodes : the selected row nodes of every subtree, depth nodes per subtree.
+ * 	depth : the depth of the split.
+ * 	count : the amount of subtrees.
+ * 	capacity : the amount of row nodes the nodes array has room for.
+ * 	solved : the amount of solutions found above the split depth.
+ * 	limit : the amount of solutions to stop at, 0 to count them all.
+ * 	found : the amount of solutions the workers found so far, protected by lock.
+ * 	lock : protects found.
+ */
+typedef struct {
+	int* nodes;
+	int depth;
+	int count;
+	int capacity;
+	int solved;
+	int limit;
+	int found;
+	pthread_mutex_t lock;
+} Tasks;
+
+/*
+ * Structure: Worker
+ * ------------------
+ * 	A counting thread. Its subtrees are tasks[head..tail), the worker takes subtrees from the tail
+ * 	and other workers steal from the head.
+ *
+ * 	thread : the thread of the worker.
+ * 	lock : protects head and tail.
+ * 	head, tail : the range of the subtrees the worker has left.
+ * 	count : the amount of solutions the worker found.
+ * 	dlx : the private exact cover matrix of the worker.
+ * 	tasks : the subtrees of the search.
+ * 	workers : all the workers.
+ * 	workers_count : the amount of workers.
+ */
+typedef struct worker {
+	pthread_t thread;
+	pthread_mutex_t lock;
+	int head;
+	int tail;
+	int count;
+	Dlx* dlx;
+	Tasks* tasks;
+	struct worker* workers;
+	int workers_count;
+} Worker;
+
+/*
+ * Function: add_task
+ * ----------------------
+ * 	Adds a subtree given by the depth row nodes of prefix.
+ */
+void add_task(Tasks* tasks, int* prefix) {
+	int i;
+
+	if ((tasks->count + 1) * tasks->depth > tasks->capacity) {
+		tasks->capacity = (tasks->count + 1) * tasks->depth * 2;
+		tasks->nodes = (int*) realloc(tasks->nodes,
+				sizeof(int) * tasks->capacity);
+		if (!tasks->nodes) {
+			printf("%s", MALLOC_ERROR);
+			exit(0);
+		}
+	}
+	for (i = 0; i < tasks->depth; i++)
+		tasks->nodes[tasks->count * tasks->depth + i] = prefix[i];
+	tasks->count += 1;
+}
+
+/*
+ * Function: split_tasks
+ * ----------------------
+ * 	Walks the search tree of the matrix down to tasks->depth, adding a subtree for every node
+ * 	at that depth. Solutions found on the way are counted in tasks->solved.
+ */
+void split_tasks(Dlx* dlx, Tasks* tasks, int* prefix, int level) {
+	int column, node;
+
+	if (dlx->right[DLX_ROOT] == DLX_ROOT) {
+		tasks->solved += 1;
+		return;
+	}
+	if (level == tasks->depth) {
+		add_task(tasks, prefix);
+		return;
+	}
+	column = dlx_choose_column(dlx);
+	for (node = dlx->down[column]; node != column; node = dlx->down[node]) {
+		prefix[level] = node;
+		dlx_select(dlx, node);
+		split_tasks(dlx, tasks, prefix, level + 1);
+		dlx_deselect(dlx, node);
+	}
+}
+
+/*
+ * Function: next_task
+ * ----------------------
+ * 	Takes a subtree from the tail of the worker, or steals one from the head of another worker.
+ *
+ * 	returns: the index of the subtree, or -1 if no subtrees are left.
+ */
+int next_task(Worker* worker) {
+	int i, task = -1;
+	Worker* victim;
+
+	pthread_mutex_lock(&worker->lock);
+	if (worker->head < worker->tail)
+		task = --worker->tail;
+	pthread_mutex_unlock(&worker->lock);
+
+	for (i = 1; task < 0 && i < worker->workers_count; i++) {
+		victim = &worker->workers[(worker - worker->workers + i)
+				% worker->workers_count];
+		pthread_mutex_lock(&victim->lock);
+		if (victim->head < victim->tail)
+			task = victim->head++;
+		pthread_mutex_unlock(&victim->lock);
+	}
+	return task;
+}
+
+/*
+ * Function: run_worker
+ * ----------------------
+ * 	The thread function of a worker, counts subtrees until none are left.
+ */
+void* run_worker(void* arg) {
+	Worker* worker = (Worker*) arg;
+	Tasks* tasks = worker->tasks;
+	int task, i, count, left = tasks->limit;
+	int* nodes;
+
+	while (left >= 0 && (task = next_task(worker)) >= 0) {
+		nodes = &tasks->nodes[task * tasks->depth];
+		for (i = 0; i < tasks->depth; i++)
+			dlx_select(worker->dlx, nodes[i]);
+		count = dlx_count_solutions(worker->dlx, left);
+		for (i = tasks->depth - 1; i >= 0; i--)
+			dlx_deselect(worker->dlx, nodes[i]);
+		worker->count += count;
+
+		if (worker->dlx->budget && !budget_charge(worker->dlx->budget, 0, 0, 0))
+			break;
+
+		/* with a limit, stop once all the workers together reached it */
+		if (tasks->limit > 0) {
+			pthread_mutex_lock(&tasks->lock);
+			tasks->found += count;
+			left = tasks->limit - tasks->found;
+			pthread_mutex_unlock(&tasks->lock);
+			if (left <= 0)
+				left = -1;
+		}
+	}
+	return NULL;
+}
+
+int parallel_count_solutions(Board* game, int threads, int limit,
+		Budget* budget) {
+	int i, count, target = threads * TASKS_PER_THREAD;
+	int* prefix;
+	Tasks tasks;
+	Worker* workers;
+	Dlx* dlx = create_dlx(game);
+
+	/* deepen the split until there are enough subtrees for all the threads */
+	prefix = (int*) malloc(sizeof(int) * (dlx->depth + 1));
+	workers = (Worker*) malloc(sizeof(Worker) * threads);
+	if (!prefix || !workers) {
+		printf("%s", MALLOC_ERROR);
+		exit(0);
+	}
+	tasks.nodes = NULL;
+	tasks.capacity = 0;
+	tasks.limit = limit > 0 ? limit : 0;
+	tasks.depth = 0;
+	do {
+		tasks.depth += 1;
+		tasks.count = 0;
+		tasks.solved = 0;
+		split_tasks(dlx, &tasks, prefix, 0);
+		tasks.found = tasks.solved;
+	} while (tasks.count > 0 && tasks.count < target
+			&& tasks.depth < dlx->depth);
+	free(prefix);
+	pthread_mutex_init(&tasks.lock, NULL);
+	if (tasks.limit > 0 && tasks.found >= tasks.limit)
+		tasks.count = 0;
+
+	/* deal the subtrees, the first worker runs on this thread */
+	for (i = 0; i < threads; i++) {
+		workers[i].head = tasks.count * i / threads;
+		workers[i].tail = tasks.count * (i + 1) / threads;
+		workers[i].count = 0;
+		workers[i].dlx = i == 0 ? dlx : create_dlx(game);
+		workers[i].dlx->budget = budget;
+		workers[i].tasks = &tasks;
+		workers[i].workers = workers;
+		workers[i].workers_count = threads;
+		pthread_mutex_init(&workers[i].lock, NULL);
+	}
+	for (i = 1; i < threads; i++) {
+		if (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i])) {
+			printf("%s", THREAD_ERROR);
+			exit(0);
+		}
+	}
+	run_worker(&workers[0]);
+
+	/* a worker may still steal from another finished one, so join all before destroying */
+	for (i = 1; i < threads; i++)
+		pthread_join(workers[i].thread, NULL);
+	count = tasks.solved;
+	for (i = 0; i < threads; i++) {
+		count += workers[i].count;
+		pthread_mutex_destroy(&workers[i].lock);
+		destroy_dlx(workers[i].dlx);
+	}
+	pthread_mutex_destroy(&tasks.lock);
+	free(workers);
+	free(tasks.nodes);
+	return tasks.limit > 0 && count > tasks.limit ? tasks.limit : count;
+}
@@ -0,0 +1,37 @@
+/*
+ * parallel.h
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include "game.h"
+#include "budget.h"
+
+/*
+ * The largest amount of threads a count can use.
+ */
+#define MAX_THREADS 64
+
+/*
+ * Function: parallel_count_solutions
+ * ----------------------
+ * 	Receives a board and counts its solutions with several threads. The search tree is split into
+ * 	subtrees at a shallow depth, the subtrees are dealt to the threads and a thread that runs out of
+ * 	subtrees steals from the others (work stealing). Every thread counts with its own exact cover
+ * 	matrix (see dlx.h), and the counts of the threads are summed, so the result is the same as the
+ * 	serial count. With a limit, the threads stop once they found limit solutions together. With a
+ * 	budget, the threads share it and stop once it is exhausted.
+ *
+ * 	game : the board to count the solutions of.
+ * 	threads : the amount of threads to use, between 1 and MAX_THREADS.
+ * 	limit : the amount of solutions to stop at, 0 to count them all.
+ * 	budget : the budget of the count, NULL for no budget.
+ *
+ * 	returns: the amount of solutions, or limit if there are at least limit solutions. If the budget
+ * 			 was exhausted, the amount of solutions found until then.
+ */
+int parallel_count_solutions(Board* game, int threads, int limit,
+		Budget* budget);
+
+#endif /* PARALLEL_H_ */
@@ -74,7 +74,8 @@ const char* get_command_name(int id) {
 	static char* names[] = { "invalid_command", "solve", "edit", "mark_errors",
 			"print_board", "set", "validate", "guess", "generate", "undo",
 			"redo", "save", "hint", "guess_hint", "num_solutions", "autofill",
-			"reset", "exit" };
+			"reset", "threads", "budget", "cache_stats", "ilp_stats", "backend",
+			"debug", "exit" };
 	if (id < INVALID_COMMAND || id > EXIT) {
 		return 0;
 	} else {
@@ -89,7 +90,7 @@ const char* get_command_name(int id) {
  */
 int get_command_id(char *type) {
 	int id;
-	if (!type || type == '\0')
+	if (!type || *type == '\0')
 		return -1;
 	for (id = INVALID_COMMAND; id <= EXIT; id++) {
 		if (!strcmp(type, get_command_name(id)))
@@ -111,8 +112,9 @@ int num_of_params(enum command_id id) {
 	case UNDO:
 	case REDO:
 	case AUTOFILL:
-	case NUM_SOLUTIONS:
 	case RESET:
+	case CACHE_STATS:
+	case ILP_STATS:
 	case EXIT:
 		return 0;
 	case SOLVE:
@@ -120,10 +122,15 @@ int num_of_params(enum command_id id) {
 	case MARK_ERORRS:
 	case GUESS:
 	case SAVE:
+	case NUM_SOLUTIONS:
+	case THREADS:
+	case BACKEND:
+	case DEBUG:
 		return 1;
 	case GENERATE:
 	case HINT:
 	case GUESS_HINT:
+	case BUDGET:
 		return 2;
 	case SET:
 		return 3;
@@ -144,6 +151,12 @@ const char* get_command_modes(enum command_id id) {
 		return NULL;
 	case SOLVE:
 	case EDIT:
+	case THREADS:
+	case BUDGET:
+	case CACHE_STATS:
+	case ILP_STATS:
+	case BACKEND:
+	case DEBUG:
 	case EXIT:
 		return modes[0];
 	case MARK_ERORRS:
@@ -178,6 +191,12 @@ int is_command_available(enum command_id id) {
 		return 0;
 	case SOLVE:
 	case EDIT:
+	case THREADS:
+	case BUDGET:
+	case CACHE_STATS:
+	case ILP_STATS:
+	case BACKEND:
+	case DEBUG:
 	case EXIT:
 		return 1;
 	case MARK_ERORRS:
@@ -208,7 +227,7 @@ int is_command_available(enum command_id id) {
  * Returns true iff the parameters of the command are optional.
  */
 int is_params_optional(enum command_id id) {
-	return id == EDIT;
+	return id == EDIT || id == NUM_SOLUTIONS;
 }
 
 /*
@@ -338,6 +357,7 @@ Command* parse_command(char *str) {
 	case SOLVE:
 	case EDIT:
 	case SAVE:
+	case BACKEND:
 		if (!fill_string_params(get_command_name(id), num_of_params(id),
 				&string_param, is_params_optional(id), error_message)) {
 			return create_command(INVALID_COMMAND, params, float_param,
@@ -18,7 +18,7 @@
 enum command_id {
 	INVALID_COMMAND, SOLVE, EDIT, MARK_ERORRS, PRINT_BOARD, SET, VALIDATE,
 	GUESS, GENERATE, UNDO, REDO, SAVE, HINT, GUESS_HINT, NUM_SOLUTIONS, AUTOFILL,
-	RESET, EXIT
+	RESET, THREADS, BUDGET, CACHE_STATS, ILP_STATS, BACKEND, DEBUG, EXIT
 };
 
 /*
@@ -0,0 +1,272 @@
+/*
+ * search.c
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "search.h"
+#include "arena.h"
+
+#define DEFAULT 0
+
+/*
+ * The last destroyed search state, kept for the next search of the same shape.
+ */
+Search* parked_search = NULL;
+
+/*
+ * Function: free_search
+ * ----------------------
+ * 	Frees the memory of a search state.
+ */
+void free_search(Search* search) {
+	release_geometry(search->geometry);
+	destroy_stack(search->stack);
+	free(search->values);
+	free(search->units_used);
+	free(search->empty);
+	free(search->position);
+	free(search);
+}
+
+Search* create_search(Board* game) {
+	int i, cells_count = game->board_size * game->board_size;
+	Search* search = parked_search;
+
+	if (search && search->geometry->block_row == game->block_row
+			&& search->geometry->block_col == game->block_col) {
+		parked_search = NULL;
+	} else {
+		search = (Search*) safe_malloc(sizeof(Search));
+		search->geometry = get_geometry(game->block_row, game->block_col);
+		search->kernels = game->kernels;
+		search->board_size = game->board_size;
+		search->values = (unsigned char*) safe_malloc(cells_count);
+		search->units_used = (OptionsSet*) safe_malloc(
+				sizeof(OptionsSet) * search->geometry->units_count);
+		search->empty = (int*) safe_malloc(sizeof(int) * cells_count);
+		search->position = (int*) safe_malloc(sizeof(int) * cells_count);
+		search->stack = init_stack();
+		reserve_stack(search->stack, cells_count);
+	}
+
+	memcpy(search->units_used, game->units_used,
+			sizeof(OptionsSet) * search->geometry->units_count);
+	search->empty_count = 0;
+	for (i = 0; i < cells_count; i++) {
+		search->values[i] = (unsigned char) game->cells[i].value;
+		if (game->cells[i].value == DEFAULT) {
+			search->position[i] = search->empty_count;
+			search->empty[search->empty_count++] = i;
+		}
+	}
+	clear_stack(search->stack);
+	return search;
+}
+
+void search_options(Search* search, int cell, OptionsSet* options) {
+	int* units = &search->geometry->cell_units[cell * UNITS_PER_CELL];
+
+	search->kernels->missing_options(options, &search->units_used[units[0]],
+			&search->units_used[units[1]], &search->units_used[units[2]],
+			search->board_size);
+}
+
+int search_choose_cell(Search* search, OptionsSet* options) {
+	int i, best = search->empty[0];
+	OptionsSet current;
+
+	search_options(search, best, options);
+	for (i = 1; i < search->empty_count && options->length > 1; i++) {
+		search_options(search, search->empty[i], &current);
+		if (current.length < options->length) {
+			best = search->empty[i];
+			*options = current;
+		}
+	}
+	return best;
+}
+
+void search_assign(Search* search, int cell, int value) {
+	int i, last;
+	int* units = &search->geometry->cell_units[cell * UNITS_PER_CELL];
+
+	search->values[cell] = (unsigned char) value;
+	for (i = 0; i < UNITS_PER_CELL; i++)
+		options_insert(&search->units_used[units[i]], value);
+
+	/* swap the cell to the end of the empty cells, search_unassign only has to grow them back */
+	last = search->empty[--search->empty_count];
+	search->empty[search->position[cell]] = last;
+	search->position[last] = search->position[cell];
+	search->empty[search->empty_count] = cell;
+	search->position[cell] = search->empty_count;
+}
+
+void search_unassign(Search* search, int cell) {
+	int i, last;
+	int* units;
+
+	do {
+		last = search->empty[search->empty_count++];
+		units = &search->geometry->cell_units[last * UNITS_PER_CELL];
+		for (i = 0; i < UNITS_PER_CELL; i++)
+			options_remove(&search->units_used[units[i]], search->values[last]);
+		search->values[last] = DEFAULT;
+	} while (last != cell);
+}
+
+/*
+ * Function: propagate_naked_singles
+ * ----------------------
+ * 	Assigns every empty cell with a single option.
+ *
+ * 	returns: -1 on a contradiction, otherwise the amount of cells assigned.
+ */
+int propagate_naked_singles(Search* search) {
+	int i, cell, assigned = 0;
+	OptionsSet options;
+
+	/* going down, assigning empty[i] only moves a cell that was already checked to place i */
+	for (i = search->empty_count - 1; i >= 0; i--) {
+		cell = search->empty[i];
+		search_options(search, cell, &options);
+		if (options.length == 0)
+			return -1;
+		if (options.length == 1) {
+			search_assign(search, cell, options_next(&options, 0));
+			assigned++;
+		}
+	}
+	return assigned;
+}
+
+/*
+ * Function: propagate_hidden_singles
+ * ----------------------
+ * 	For every unit, assigns a value that only one empty cell of the unit can hold. At most one value
+ * 	is assigned in every unit, the next pass picks up the rest.
+ *
+ * 	returns: -1 on a contradiction, otherwise the amount of cells assigned.
+ */
+int propagate_hidden_singles(Search* search) {
+	int u, i, w, cell, value, assigned = 0, n = search->board_size;
+	int* cells;
+	OptionsSet options, once, twice, missing;
+
+	for (u = 0; u < search->geometry->units_count; u++) {
+		/* once: values some empty cell can hold, twice: values at least two can hold */
+		options_clear(&once);
+		options_clear(&twice);
+		cells = &search->geometry->units[u * n];
+		for (i = 0; i < n; i++) {
+			if (search->values[cells[i]] != DEFAULT)
+				continue;
+			search_options(search, cells[i], &options);
+			for (w = 0; w < (int) OPTIONS_WORDS; w++) {
+				twice.words[w] |= once.words[w] & options.words[w];
+				once.words[w] |= options.words[w];
+			}
+		}
+
+		options_fill(&missing, n);
+		value = DEFAULT;
+		for (w = 0; w < (int) OPTIONS_WORDS; w++) {
+			missing.words[w] &= ~search->units_used[u].words[w];
+			if (missing.words[w] & ~once.words[w])
+				return -1;
+			once.words[w] &= ~twice.words[w];
+			if (value == DEFAULT && once.words[w])
+				value = options_next(&once, w * OPTIONS_WORD_BITS);
+		}
+		if (value == DEFAULT)
+			continue;
+
+		for (i = 0; i < n; i++) {
+			cell = cells[i];
+			if (search->values[cell] != DEFAULT)
+				continue;
+			search_options(search, cell, &options);
+			if (options_contains(&options, value)) {
+				search_assign(search, cell, value);
+				assigned++;
+				break;
+			}
+		}
+	}
+	return assigned;
+}
+
+int search_propagate(Search* search) {
+	int assigned;
+
+	do {
+		assigned = propagate_naked_singles(search);
+		if (assigned < 0)
+			return 0;
+		if (assigned == 0)
+			assigned = propagate_hidden_singles(search);
+		if (assigned < 0)
+			return 0;
+	} while (assigned > 0 && search->empty_count > 0);
+	return 1;
+}
+
+int search_solve(Search* search) {
+	int cell, value, n = search->board_size;
+	int start = search->empty_count;
+	OptionsSet options;
+	StackNode node;
+	Stack* stack = search->stack;
+
+	clear_stack(stack);
+	for (;;) {
+		/* go down: propagate, then branch on the most constrained cell, starting from its smallest option */
+		value = DEFAULT;
+		if (search_propagate(search)) {
+			if (search->empty_count == 0) {
+				return 1;
+			} else {
+				cell = search_choose_cell(search, &options);
+				value = options_next(&options, 0);
+			}
+		}
+		if (value != DEFAULT) {
+			push(stack, cell / n, cell % n, value);
+			search_assign(search, cell, value);
+			continue;
+		}
+
+		/* go up until a cell has another option to try, rolling back everything assigned after it */
+		while (value == DEFAULT && !is_empty(stack)) {
+			pop(stack, &node);
+			cell = node.row * n + node.column;
+			search_unassign(search, cell);
+			search_options(search, cell, &options);
+			value = options_next(&options, node.value);
+		}
+		if (value == DEFAULT)
+			break;
+		push(stack, cell / n, cell % n, value);
+		search_assign(search, cell, value);
+	}
+
+	/* roll back what was propagated before the first branch */
+	if (search->empty_count < start)
+		search_unassign(search, search->empty[start - 1]);
+	return 0;
+}
+
+void destroy_search(Search* search) {
+	if (!search)
+		return;
+	if (parked_search)
+		free_search(parked_search);
+	parked_search = search;
+}
+
+void clear_searches() {
+	if (parked_search)
+		free_search(parked_search);
+	parked_search = NULL;
+}
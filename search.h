@@ -0,0 +1,141 @@
+/*
+ * search.h
+ */
+
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include "game.h"
+#include "stack.h"
+
+/*
+ * Structure: Search
+ * ------------------
+ * 	A compact scratch copy of a board, used by the native solver and the ILP presolve instead of the
+ * 	board itself.
+ * 	Only the values and the used values of every unit are kept, the options of an empty cell are
+ * 	the values missing from its three units. Errors and options of the cells are not maintained.
+ *
+ * 	geometry : the geometry of the board.
+ * 	kernels : the kernels of the board's shape, used to find the options of a cell.
+ * 	board_size : an integer representing how many rows and columns the board have.
+ * 	values : for every cell, its value (0 for an empty cell).
+ * 	units_used : for every unit, the set of the values in it.
+ * 	empty : the empty cells, in the first empty_count places. The cells assigned by the search follow
+ * 	        them, the last assigned first, so the rest of the array is the trail of the search.
+ * 	empty_count : the amount of empty cells.
+ * 	position : for every cell that was empty, its place in empty.
+ * 	stack : the branches of the search, with room for a branch on every cell.
+ */
+typedef struct {
+	Geometry* geometry;
+	const Kernels* kernels;
+	int board_size;
+	unsigned char* values;
+	OptionsSet* units_used;
+	int* empty;
+	int empty_count;
+	int* position;
+	Stack* stack;
+} Search;
+
+/*
+ * Function: create_search
+ * ----------------------
+ * 	Receives a board without errors and creates a search state of it. The board is not changed
+ * 	by the search. The state destroyed last is reused when it has the shape of the board, so
+ * 	a search per command allocates nothing once the first one was made. Search states are
+ * 	not shared between threads.
+ *
+ * 	game : the board to copy.
+ *
+ * 	returns: a pointer to the search state.
+ */
+Search* create_search(Board* game);
+
+/*
+ * Function: search_options
+ * ----------------------
+ * 	Receives a search state and an empty cell, and fills a set with the values the cell can hold.
+ *
+ * 	search : the search state.
+ * 	cell : the linear index of the cell.
+ * 	options : the set to fill.
+ */
+void search_options(Search* search, int cell, OptionsSet* options);
+
+/*
+ * Function: search_choose_cell
+ * ----------------------
+ * 	Receives a search state with empty cells and finds the empty cell with the fewest options
+ * 	(minimum remaining values), stopping early at a cell with none or one.
+ *
+ * 	search : the search state.
+ * 	options : the set to fill with the options of the chosen cell.
+ *
+ * 	returns: the linear index of the chosen cell.
+ */
+int search_choose_cell(Search* search, OptionsSet* options);
+
+/*
+ * Function: search_assign
+ * ----------------------
+ * 	Receives a search state, an empty cell and a value, and sets the value in the cell.
+ */
+void search_assign(Search* search, int cell, int value);
+
+/*
+ * Function: search_unassign
+ * ----------------------
+ * 	Receives a search state and a cell assigned by the search, and empties the cell and all the cells
+ * 	assigned after it (rolls the trail back to before the cell was assigned).
+ */
+void search_unassign(Search* search, int cell);
+
+/*
+ * Function: search_propagate
+ * ----------------------
+ * 	Receives a search state and assigns every forced cell until none are left: a cell with a single
+ * 	option (naked single), and a value that only one cell of a unit can hold (hidden single).
+ * 	The assigned cells are on the trail, so search_unassign rolls them back.
+ *
+ * 	search : the search state.
+ *
+ * 	returns: 0 if a contradiction was found (a cell with no options or a value that no cell of a
+ * 			 unit can hold), 1 otherwise.
+ */
+int search_propagate(Search* search);
+
+/*
+ * Function: search_solve
+ * ----------------------
+ * 	Receives a search state and searches it for a solution by backtracking. Every node of the search
+ * 	is propagated first (see search_propagate), then the search branches on the cell with the fewest
+ * 	options and tries only its options. The search does no heap allocations. On success the values
+ * 	of the search hold the solution and the state is not restored, so the search can only be
+ * 	destroyed afterwards; otherwise the state is restored.
+ *
+ * 	search : the search state.
+ *
+ * 	returns: 1 if a solution was found, 0 if the state has no solution.
+ */
+int search_solve(Search* search);
+
+/*
+ * Function: destroy_search
+ * ------------------------
+ * 	Used to destroy a search state. The state is kept for the next create_search, and the one kept
+ * 	before it is freed.
+ *
+ * 	search : a pointer to the search state.
+ */
+void destroy_search(Search* search);
+
+/*
+ * Function: clear_searches
+ * ------------------------
+ * 	Frees the search state kept by destroy_search, if any.
+ */
+void clear_searches();
+
+#endif /* SEARCH_H_ */
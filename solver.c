@@ -26,9 +26,14 @@
 #define NO_HINT_AVAILABLE "Board is unsolvable so no hint is available\n"
 #define EXCEEDED_MAX_ITERS "Tried to generate board for 1000 times and didn't succeed\n"
 #define ERRORS_EXIST "Errors exist in board\n"
+#define SOLVER_FAILED "Error: the solver failed, use the backend command to pick another one\n"
 
 Board* board = NULL;
 TurnsList* turns_list = NULL;
+int solver_threads = 1;
+int solver_seconds = 0;
+int solver_nodes = 0;
+const SolverBackend* solver_backend = &native_backend;
 
 int is_finished(Board* game) {
 	return (!num_of_empty_cells(game) && !is_there_errors(game));
@@ -38,7 +43,7 @@ void set_value_command(Board* game, int row, int col, int value,
 		TurnsList* turns) {
 	int prev_val;
 	MovesList* moves;
-	prev_val = game->current[row - 1][col - 1].value;
+	prev_val = GET_CELL(game, row - 1, col - 1)->value;
 	set_value(game, row, col, value);
 	moves = create_moves_list();
 	insert_move(moves, row, col, prev_val, value);
@@ -48,127 +53,64 @@ void set_value_command(Board* game, int row, int col, int value,
 int validate_board(Board* game) {
 	int valid;
 	Board* copy;
+
+	valid = cache_get_solvable(game);
+	if (valid >= 0)
+		return valid;
+
 	copy = create_board_copy(game);
-	valid = ilp(copy);
+	valid = solver_backend->solve(copy);
+	if (valid == 1)
+		cache_put_solution(game, copy);
+	else if (valid == 0)
+		cache_put_unsolvable(game);
 	destroy_board(copy);
 	return valid;
 }
 
-/*
- * Function: get_first_empty_cell
- * ----------------------
- * 	Receives a Board, and two pointers. Finds the first empty cell and change the pointers value accordingly.
- *
- * 	returns: 1 if there's an empty cell, 0 otherwise.
- */
-int get_first_empty_cell(Board* game, int* row, int* col) {
-	int i = 0, j = 0;
-	for (; i < game->board_size; i++) {
-		for (j = 0; j < game->board_size; j++) {
-			if (game->current[i][j].value == DEFAULT
-					&& game->current[i][j].isFixed == 0) {
-				*row = i;
-				*col = j;
-				return 1;
-			}
-		}
-	}
-	return 0;
-}
-
 int number_of_solutions(Board* game) {
-	int count = 0;
-	int row = 0, col = 0;
-	StackNode* node;
-	Stack* stack = init_stack();
+	return count_solutions(game, 0);
+}
 
-	node = (StackNode*) malloc(sizeof(StackNode));
-	if (!node) {
-		printf("%s", MALLOC_ERROR);
-		exit(0);
-	}
+int count_solutions(Board* game, int limit) {
+	return count_solutions_budgeted(game, limit, NULL);
+}
 
-	if (!validate_board(game)) {
-		destroy_stack(stack);
-		free(node);
-		return 0;
-	}
+int count_solutions_budgeted(Board* game, int limit, Budget* budget) {
+	int count;
+	Dlx* dlx;
 
-	if (!get_first_empty_cell(game, &row, &col)) {
-		destroy_stack(stack);
-		free(node);
-		return 1;
-	}
+	count = cache_get_count(game, limit);
+	if (count >= 0)
+		return count;
 
-	push(stack, row, col, 1);
-	while (!is_empty(stack)) {
-		if (is_value_valid(game, stack->top->row, stack->top->column,
-				stack->top->value)) {
-			set_value(game, stack->top->row + 1, stack->top->column + 1,
-					stack->top->value);
-			if (get_first_empty_cell(game, &row, &col)) {
-				push(stack, row, col, 1);
-			} else { /* board is complete */
-				count += 1;
-				set_value(game, stack->top->row + 1, stack->top->column + 1,
-				DEFAULT);
-				if (stack->top->value < game->board_size) /* we can try another value for this cell */
-					stack->top->value += 1;
-				else {
-					while (!is_empty(stack)
-							&& stack->top->value == game->board_size) { /* pop until we find a cell to modify */
-						set_value(game, stack->top->row + 1,
-								stack->top->column + 1,
-								DEFAULT);
-						pop(stack, node);
-					}
-					if (!is_empty(stack))
-						stack->top->value += 1;
-				}
-			}
-		} else {
-			if (stack->top->value < game->board_size) { /* we can try another value for this cell */
-				stack->top->value += 1;
-			} else {
-				while (!is_empty(stack) && stack->top->value == game->board_size) { /* pop until we find a cell to modify */
-					set_value(game, stack->top->row + 1, stack->top->column + 1,
-					DEFAULT);
-					pop(stack, node);
-				}
-				if (!is_empty(stack))
-					stack->top->value += 1;
-			}
-		}
+	if (solver_threads > 1) {
+		count = parallel_count_solutions(game, solver_threads, limit, budget);
+	} else {
+		dlx = create_dlx(game);
+		dlx->budget = budget;
+		count = dlx_count_solutions(dlx, limit);
+		destroy_dlx(dlx);
 	}
-
-	destroy_stack(stack);
-	free(node);
-
+	cache_put_count(game, count,
+			!(budget && budget->exhausted) && !(limit > 0 && count == limit));
 	return count;
 }
 
 void check_errors_in_board(Board* game) {
-	int row, col, value;
+	int row, col;
 
 	for (row = 0; row < game->board_size; row++)
-		for (col = 0; col < game->board_size; col++) {
-			value = game->current[row][col].value;
-			game->current[row][col].value = DEFAULT;
-			if (value == DEFAULT || is_value_valid(game, row, col, value))
-				game->current[row][col].isError = 0;
-			else
-				game->current[row][col].isError = 1;
-			game->current[row][col].value = value;
-		}
+		for (col = 0; col < game->board_size; col++)
+			GET_CELL(game, row, col)->isError = is_cell_error(game, row, col);
 }
 
 int is_there_errors(Board* game) {
-	int row, col;
+	int i;
 
-	for (row = 0; row < game->board_size; row++)
-		for (col = 0; col < game->board_size; col++)
-			if (game->current[row][col].isError)
-				return 1;
+	for (i = 0; i < game->board_size * game->board_size; i++)
+		if (game->cells[i].isError)
+			return 1;
 	return 0;
 }
 
@@ -189,10 +131,10 @@ int guess_solution(Board* game, TurnsList* turns, float t) {
 	moves = create_moves_list();
 	for (i = 0; i < game->board_size; i++) {
 		for (j = 0; j < game->board_size; j++) {
-			if (game->current[i][j].value != copy->current[i][j].value) {
-				insert_move(moves, i + 1, j + 1, game->current[i][j].value,
-						copy->current[i][j].value);
-				set_value(game, i + 1, j + 1, copy->current[i][j].value);
+			if (GET_CELL(game, i, j)->value != GET_CELL(copy, i, j)->value) {
+				insert_move(moves, i + 1, j + 1, GET_CELL(game, i, j)->value,
+						GET_CELL(copy, i, j)->value);
+				set_value(game, i + 1, j + 1, GET_CELL(copy, i, j)->value);
 			}
 		}
 	}
@@ -203,23 +145,16 @@ int guess_solution(Board* game, TurnsList* turns, float t) {
 }
 
 int num_of_empty_cells(Board* game) {
-	int count = 0, row, col;
+	int count = 0, i;
 
-	for (row = 0; row < game->board_size; row++)
-		for (col = 0; col < game->board_size; col++)
-			if (game->current[row][col].value == DEFAULT)
-				count++;
+	for (i = 0; i < game->board_size * game->board_size; i++)
+		if (game->cells[i].value == DEFAULT)
+			count++;
 	return count;
 }
 
 int get_random_value(Cell* cell) {
-	int r;
-	OptionNode* node = cell->options->top;
-
-	r = rand() % cell->options->length;
-	for (; r >= 0; r--)
-		node = node->next;
-	return node->value;
+	return options_select(&cell->options, rand() % cell->options.length);
 }
 
 int generate_board(Board* game, TurnsList* turns, int x, int y) {
@@ -229,7 +164,7 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 	MovesList* moves;
 	Board* copy;
 
-	if (!validate_board(game)) {
+	if (!count_solutions(game, 1)) {
 		printf("%s", VALIDATION_FAILED);
 		return 0;
 	}
@@ -248,8 +183,8 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 			/* find and allocate values to x random cells */
 			rRow = rand() % game->board_size;
 			rCol = rand() % game->board_size;
-			if (game->current[rRow][rCol].value == DEFAULT) {
-				if (game->current[rRow][rCol].options->length == 0) {
+			if (GET_CELL(game, rRow, rCol)->value == DEFAULT) {
+				if (GET_CELL(game, rRow, rCol)->options.length == 0) {
 					for (k = 0; k < count; k++) {
 						set_value(game, rows[k] + 1, cols[k] + 1, DEFAULT);
 						rows[k] = 0;
@@ -261,7 +196,7 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 				rows[j] = rRow;
 				cols[j] = rCol;
 				set_value(game, rRow + 1, rCol + 1,
-						get_random_value(&game->current[rRow][rCol]));
+						get_random_value(GET_CELL(game, rRow, rCol)));
 				count += 1;
 			} else
 				j--;
@@ -269,17 +204,24 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 		if (x != 0 && !count)
 			continue;
 
-		k = ilp(game);
-		if (k == 0) {
-			for (k = 0; k < count; k++) {
-				set_value(game, rows[k] + 1, cols[k] + 1, DEFAULT);
-				rows[k] = 0;
-				cols[k] = 0;
+		k = solver_backend->solve(game);
+		if (k != 1) {
+			for (j = 0; j < count; j++) {
+				set_value(game, rows[j] + 1, cols[j] + 1, DEFAULT);
+				rows[j] = 0;
+				cols[j] = 0;
 			}
 			count = 0;
-		} else {
-			break;
 		}
+		if (k == SOLVE_ERROR) {
+			free(rows);
+			free(cols);
+			destroy_board(copy);
+			printf("%s", SOLVER_FAILED);
+			return 0;
+		}
+		if (k == 1)
+			break;
 	}
 
 	if (i == MAX_ITERS) {
@@ -295,7 +237,7 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 	for (i = 0; i < game->board_size * game->board_size - y; i++) {
 		rRow = rand() % game->board_size;
 		rCol = rand() % game->board_size;
-		if (game->current[rRow][rCol].value == DEFAULT)
+		if (GET_CELL(game, rRow, rCol)->value == DEFAULT)
 			i--;
 		else {
 			set_value(game, rRow + 1, rCol + 1, DEFAULT);
@@ -304,9 +246,9 @@ int generate_board(Board* game, TurnsList* turns, int x, int y) {
 
 	for (i = 0; i < game->board_size; i++) {
 		for (j = 0; j < game->board_size; j++) {
-			if (game->current[i][j].value != copy->current[i][j].value)
-				insert_move(moves, i + 1, j + 1, copy->current[i][j].value,
-						game->current[i][j].value);
+			if (GET_CELL(game, i, j)->value != GET_CELL(copy, i, j)->value)
+				insert_move(moves, i + 1, j + 1, GET_CELL(copy, i, j)->value,
+						GET_CELL(game, i, j)->value);
 		}
 	}
 
@@ -327,22 +269,38 @@ int get_hint(Board* game, int row, int col, int type) {
 		return -1;
 	}
 
-	if (game->current[row][col].isFixed) {
+	if (GET_CELL(game, row, col)->isFixed) {
 		printf("%s", FIXED_CELL);
 		return -1;
 	}
-	if (game->current[row][col].value != DEFAULT) {
+	if (GET_CELL(game, row, col)->value != DEFAULT) {
 		printf("%s", FILLED_CELL);
 		return -1;
 	}
 
-	copy = create_board_copy(game);
 	if (type) {
-		if (!ilp(copy)) {
+		value = cache_get_solution_value(game, CELL_INDEX(game, row, col));
+		if (value < 0) {
 			printf("%s", NO_HINT_AVAILABLE);
+			return 0;
+		}
+		if (value > 0)
+			return value;
+	}
+
+	copy = create_board_copy(game);
+	if (type) {
+		value = solver_backend->solve(copy);
+		if (value != 1) {
+			if (value == 0) {
+				cache_put_unsolvable(game);
+				printf("%s", NO_HINT_AVAILABLE);
+			} else
+				printf("%s", SOLVER_FAILED);
 			destroy_board(copy);
 			return 0;
 		}
+		cache_put_solution(game, copy);
 	} else {
 		if (!lp(copy, 0, 1, row, col)) {
 			printf("%s", NO_HINT_AVAILABLE);
@@ -351,7 +309,7 @@ int get_hint(Board* game, int row, int col, int type) {
 		}
 	}
 
-	value = copy->current[row][col].value;
+	value = GET_CELL(copy, row, col)->value;
 	destroy_board(copy);
 	return value;
 }
@@ -371,15 +329,15 @@ int auto_fill(Board* game, TurnsList* turns) {
 
 	for (row = 0; row < game->board_size; row++)
 		for (col = 0; col < game->board_size; col++) {
-			if (copy->current[row][col].value == DEFAULT
-					&& copy->current[row][col].options->length == 1) {
+			if (GET_CELL(copy, row, col)->value == DEFAULT
+					&& GET_CELL(copy, row, col)->options.length == 1) {
 				set_value(game, row + 1, col + 1,
-						copy->current[row][col].options->top->value);
+						options_select(&GET_CELL(copy, row, col)->options, 0));
 				insert_move(moves, row + 1, col + 1, DEFAULT,
-						game->current[row][col].value);
+						GET_CELL(game, row, col)->value);
 				printf("Cell <%d,%d> has been auto-filled with the value %d\n",
 						row + 1, col + 1,
-						copy->current[row][col].options->top->value);
+						options_select(&GET_CELL(copy, row, col)->options, 0));
 			}
 		}
 
@@ -466,11 +424,27 @@ void print_image() {
 	}
 }
 
+/*
+ * Function: show_board
+ * ----------------------
+ * 	Prints the board after a command. Large boards are summarized instead, they are only
+ * 	printed in full by the print_board command.
+ */
+void show_board(Board* game) {
+	if (game->board_size > LARGE_BOARD_SIZE)
+		printf("Board %dx%d: %d empty cells%s (use print_board to see it)\n",
+				game->board_size, game->board_size, num_of_empty_cells(game),
+				is_there_errors(game) ? ", errors exist" : "");
+	else
+		print_board(game);
+}
+
 int execute_command(Command* cmd) {
 	int x = cmd->params[0], y = cmd->params[1], z = cmd->params[2];
 	float float_param = cmd->float_param;
 	char* path = cmd->string_param;
 	int tmp;
+	Budget budget;
 	switch (cmd->id) {
 	case INVALID_COMMAND:
 		printf("%s\n", cmd->error_message);
@@ -488,7 +462,7 @@ int execute_command(Command* cmd) {
 		}
 		turns_list = create_turns_list();
 		current_game_mode = GAME_MODE_SOLVE;
-		print_board(board);
+		show_board(board);
 		break;
 
 	case EDIT:
@@ -507,7 +481,7 @@ int execute_command(Command* cmd) {
 		}
 		turns_list = create_turns_list();
 		current_game_mode = GAME_MODE_EDIT;
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case MARK_ERORRS:
@@ -518,6 +492,40 @@ int execute_command(Command* cmd) {
 		mark_errors = x;
 		return 1;
 
+	case DEBUG:
+		if (x < 0 || x > 1) {
+			printf("Error: first parameter out of range. Should be 0 or 1.\n");
+			break;
+		}
+		ilp_set_debug(x);
+		return 1;
+
+	case THREADS:
+		if (x < 1 || x > MAX_THREADS) {
+			printf("Error: first parameter out of range. Should be between 1 and %d.\n",
+					MAX_THREADS);
+			break;
+		}
+		solver_threads = x;
+		return 1;
+
+	case BUDGET:
+		if (x < 0 || y < 0) {
+			printf("Error: parameters out of range. Should be 0 (no limit) or more.\n");
+			break;
+		}
+		solver_seconds = x;
+		solver_nodes = y;
+		return 1;
+
+	case BACKEND:
+		if (!find_backend(path)) {
+			printf("Error: first parameter should be native or gurobi.\n");
+			break;
+		}
+		solver_backend = find_backend(path);
+		return 1;
+
 	case PRINT_BOARD:
 		print_board(board);
 		return 1;
@@ -542,12 +550,12 @@ int execute_command(Command* cmd) {
 			break;
 		}
 		if (current_game_mode == GAME_MODE_SOLVE
-				&& board->current[x - 1][y - 1].isFixed) {
+				&& GET_CELL(board, x - 1, y - 1)->isFixed) {
 			printf("Cannot change fixed cells while in solve mode\n");
 			break;
 		}
 		set_value_command(board, x, y, z, turns_list);
-		print_board(board);
+		show_board(board);
 		if (current_game_mode == GAME_MODE_SOLVE
 				&& !num_of_empty_cells(board)) {
 			if (!is_there_errors(board)) {
@@ -566,12 +574,17 @@ int execute_command(Command* cmd) {
 			break;
 		}
 
-		if (validate_board(board)) {
+		tmp = validate_board(board);
+		if (tmp == SOLVE_ERROR) {
+			printf("%s", SOLVER_FAILED);
+			break;
+		}
+		if (tmp) {
 			printf("Board is solvable\n");
 		} else {
 			printf("Board is not solvable\n");
 		}
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case GUESS:
@@ -585,7 +598,7 @@ int execute_command(Command* cmd) {
 			break;
 		}
 		printf("We found a solution for you\n");
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case GENERATE:
@@ -598,17 +611,17 @@ int execute_command(Command* cmd) {
 			return 1;
 		}
 		generate_board(board, turns_list, x, y);
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case UNDO:
 		undo(board, turns_list, 1);
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case REDO:
 		redo(board, turns_list);
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case SAVE:
@@ -617,7 +630,7 @@ int execute_command(Command* cmd) {
 				printf("Errors exist in board, can not save\n");
 				return 1;
 			}
-			if (!validate_board(board)) {
+			if (!count_solutions(board, 1)) {
 				printf("Board is not solvable, can not save\n");
 				return 1;
 			}
@@ -670,23 +683,48 @@ int execute_command(Command* cmd) {
 			printf("Errors exist in board\n");
 			return 1;
 		}
-		tmp = number_of_solutions(board);
-		if (tmp != -1)
-			printf("Number of possible solutions: %d\n",
-					number_of_solutions(board));
+		if (x < 0) {
+			printf("Error: first parameter out of range. Should be 0 or more.\n");
+			break;
+		}
+		budget_init(&budget, solver_seconds, solver_nodes, 1);
+		tmp = count_solutions_budgeted(board, x, &budget);
+		if (budget.exhausted)
+			printf("Number of possible solutions: at least %d (partial count, "
+					"the budget ran out after %ld nodes)\n", tmp, budget.nodes);
+		else if (x > 0 && tmp == x)
+			printf("Number of possible solutions: at least %d\n", tmp);
+		else
+			printf("Number of possible solutions: %d\n", tmp);
+		budget_destroy(&budget);
 		return 1;
 
 	case AUTOFILL:
 		auto_fill(board, turns_list);
-		print_board(board);
+		show_board(board);
 		return 1;
 
 	case RESET:
 		reset_board(board, turns_list);
-		print_board(board);
+		show_board(board);
+		return 1;
+
+	case CACHE_STATS:
+		printf("Cache: %ld hits, %ld misses\n", cache_hits, cache_misses);
+		return 1;
+
+	case ILP_STATS:
+		printf("ILP: %ld models (%ld reused), %.3f s building, %.3f s solving\n",
+				ilp_models, ilp_reuses, ilp_build_seconds, ilp_solve_seconds);
+		printf("Presolve: %ld solved, %ld unsolvable, %ld variables eliminated\n",
+				ilp_presolve_solved, ilp_presolve_unsolvable,
+				ilp_presolve_eliminated);
 		return 1;
 
 	case EXIT:
+		cache_clear();
+		ilp_teardown();
+		clear_searches();
 		destroy_board(board);
 		destroy_turns_list(turns_list);
 		printf("Exiting...\n");
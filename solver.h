@@ -14,6 +14,28 @@
 #include "stack.h"
 #include "ILP_solver.h"
 #include "parser.h"
+#include "dlx.h"
+#include "search.h"
+#include "parallel.h"
+#include "cache.h"
+#include "backend.h"
+
+/*
+ * The amount of threads number_of_solutions uses, set by the threads command.
+ */
+extern int solver_threads;
+
+/*
+ * The wall clock seconds and the search nodes the num_solutions command may use, 0 for no limit,
+ * set by the budget command.
+ */
+extern int solver_seconds;
+extern int solver_nodes;
+
+/*
+ * The backend validate, hint and generate solve boards with, set by the backend command.
+ */
+extern const SolverBackend* solver_backend;
 
 /*
  * Function: is_finished
@@ -46,18 +68,25 @@ void set_value_command(Board* game, int row, int col, int value, TurnsList* turn
 /*
  * Function: validate_board
  * ----------------------
- * 	Receives a Board, and uses ILP solver to determine whether it is solvable.
+ * 	Receives a Board, and solves it with the selected backend (see solver_backend) to determine
+ * 	whether it is solvable. The result and the solution found are remembered for the board's
+ * 	position (see cache.h), and a position already known is answered without solving.
  *
  * 	game : the Board which holds the current board.
  *
- * 	returns: 1 if the board is solvable, 0 otherwise.
+ * 	returns: 1 if the board is solvable, 0 if it isn't, SOLVE_ERROR if the solver failed (which is
+ * 			 not remembered).
  */
 int validate_board(Board* game);
 
 /*
  * Function: number_of_solutions
  * ----------------------
- * 	Receives a Board, and uses backtracking algorithm to count number of possible solutions.
+ * 	Receives a Board, and counts the number of possible solutions by solving it as an exact cover
+ * 	problem with dancing links (see dlx.h). Counts are remembered for the board's position (see
+ * 	cache.h). A board with no solution is detected by the search itself,
+ * 	so no ILP validation is needed first. With more than one solver thread the search is split over
+ * 	the threads (see parallel.h), the result is the same.
  *
  * 	game : the Board which holds the current board.
  *
@@ -65,6 +94,36 @@ int validate_board(Board* game);
  */
 int number_of_solutions(Board* game);
 
+/*
+ * Function: count_solutions
+ * ----------------------
+ * 	Receives a Board and a limit, and counts the possible solutions like number_of_solutions, but
+ * 	stops as soon as limit solutions are found. A limit of 1 tells whether the board is solvable,
+ * 	a limit of 2 whether its solution is unique.
+ *
+ * 	game : the Board which holds the current board.
+ * 	limit : the amount of solutions to stop at, 0 to count them all.
+ *
+ * 	returns: the amount of solutions, or limit if there are at least limit solutions.
+ */
+int count_solutions(Board* game, int limit);
+
+/*
+ * Function: count_solutions_budgeted
+ * ----------------------
+ * 	Receives a Board, a limit and a budget, and counts the possible solutions like count_solutions,
+ * 	charging the search to the budget. The count stops when the budget is exhausted, which the budget
+ * 	tells afterwards.
+ *
+ * 	game : the Board which holds the current board.
+ * 	limit : the amount of solutions to stop at, 0 to count them all.
+ * 	budget : the budget of the count, NULL for no budget.
+ *
+ * 	returns: the amount of solutions, or limit if there are at least limit solutions. If the budget
+ * 			 was exhausted, the amount of solutions found until then.
+ */
+int count_solutions_budgeted(Board* game, int limit, Budget* budget);
+
 /*
  * Function: check_errors_in_board
  * ----------------------
@@ -125,7 +184,8 @@ int get_random_value(Cell* cell);
  * Function: generate_board
  * ----------------------
  * 	Receives a Board, undo list, and two integers representing the x,y arguments of the generate command,
- * 	then it tries to generate a board to solve, while leaving only y cells revealed.
+ * 	then it tries to generate a board to solve, while leaving only y cells revealed. The random
+ * 	fillings are completed by the selected backend (see solver_backend).
  *
  * 	game : the Board which holds the current board.
  * 	turns : the undo list of this game.
@@ -145,7 +205,9 @@ int generate_board(Board* game, TurnsList* turns, int x, int y);
  * 	game : the Board which holds the current board.
  * 	row : the row of the requested cell.
  * 	col : the column of the requested cell.
- * 	type : 0 is for guess_hint (using LP), 1 is for hint (using ILP).
+ * 	type : 0 is for guess_hint (using LP), 1 is for hint (solving with the selected backend, see
+ * 			solver_backend). Hints are taken from the solution remembered for the board's
+ * 			position when there is one (see cache.h).
  *
  * 	returns: the hint as an integer, or 0 if no hint is available.
  */
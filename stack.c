@@ -11,6 +11,7 @@
 #include "stack.h"
 
 #define MALLOC_ERROR "Error: malloc has failed\n"
+#define INITIAL_CAPACITY 16
 
 Stack* init_stack() {
 	Stack* stack = (Stack*) malloc(sizeof(Stack));
@@ -18,42 +19,52 @@ Stack* init_stack() {
 		printf(MALLOC_ERROR);
 		exit(0);
 	}
-	stack->top = NULL;
+	stack->nodes = NULL;
 	stack->length = 0;
+	stack->capacity = 0;
 
 	return stack;
 }
 
-void push(Stack* stack, int row, int col, int val) {
-	StackNode* node = (StackNode*) malloc(sizeof(StackNode));
-	if (node == NULL) {
+void reserve_stack(Stack* stack, int capacity) {
+	StackNode* nodes;
+	if (capacity <= stack->capacity)
+		return;
+
+	nodes = (StackNode*) realloc(stack->nodes, sizeof(StackNode) * capacity);
+	if (nodes == NULL) {
 		printf(MALLOC_ERROR);
 		exit(0);
 	}
+	stack->nodes = nodes;
+	stack->capacity = capacity;
+}
+
+void clear_stack(Stack* stack) {
+	stack->length = 0;
+}
 
+void push(Stack* stack, int row, int col, int val) {
+	StackNode* node;
+	if (stack->length == stack->capacity)
+		reserve_stack(stack,
+				stack->capacity ? stack->capacity * 2 : INITIAL_CAPACITY);
+
+	node = &stack->nodes[stack->length];
 	node->column = col;
 	node->row = row;
 	node->value = val;
-	node->prev = stack->top;
 
-	stack->top = node;
 	stack->length = stack->length + 1;
 }
 
 void pop(Stack* stack, StackNode* popped) {
-	StackNode* tmp = stack->top;
-	popped->row = tmp->row;
-	popped->column = tmp->column;
-	popped->value = tmp->value;
-
-	stack->top = stack->top->prev;
 	stack->length = stack->length - 1;
-
-	free(tmp);
+	*popped = stack->nodes[stack->length];
 }
 
 StackNode* top(Stack* stack) {
-	return stack->top;
+	return &stack->nodes[stack->length - 1];
 }
 
 int is_empty(Stack* stack) {
@@ -61,9 +72,6 @@ int is_empty(Stack* stack) {
 }
 
 void destroy_stack(Stack* stack) {
-	StackNode* tmp = NULL;
-	while (!is_empty(stack)) {
-		pop(stack, tmp);
-	}
+	free(stack->nodes);
 	free(stack);
 }
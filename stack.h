@@ -17,26 +17,27 @@
  * 	column : an integer representing the changed cell's column.
  * 	row : an integer representing the changed cell's row.
  * 	value : an integer representing the changed cell's value.
- * 	prev : a pointer to the previous node in the stack.
  */
 typedef struct node {
     int column;
     int row;
     int value;
-    struct node* prev;
 } StackNode;
 
 /*
  * Structure: stack
  * ------------------
- * 	A structure used to represent a stack
+ * 	A structure used to represent a stack. The nodes are kept in one contiguous array that only grows,
+ * 	so once the stack is big enough push and pop don't allocate.
  *
- * 	top : a pointer to the top element of the stack.
+ * 	nodes : the nodes of the stack, the bottom first.
  * 	length : an integer representing the stack's length.
+ * 	capacity : an integer representing the amount of nodes the array has room for.
  */
 typedef struct stack {
-	StackNode* top;
+	StackNode* nodes;
 	int length;
+	int capacity;
 } Stack;
 
 
@@ -49,6 +50,25 @@ typedef struct stack {
  */
 Stack* init_stack();
 
+/*
+ * Function: reserve_stack
+ * ----------------------
+ * 	Receives a stack and a capacity, and makes room for that many nodes, so pushing them won't allocate.
+ *
+ *	stack : a pointer to the stack
+ * 	capacity : the amount of nodes to make room for.
+ */
+void reserve_stack(Stack* stack, int capacity);
+
+/*
+ * Function: clear_stack
+ * ----------------------
+ * 	Receives a stack and removes all the nodes from it, keeping its room for reuse.
+ *
+ *	stack : a pointer to the stack
+ */
+void clear_stack(Stack* stack);
+
 /*
  * Function: push
  * ----------------------
@@ -83,7 +103,7 @@ void pop(Stack* stack, StackNode* popped);
  *
  *	stack : a pointer to the stack
  *
- * 	returns: a pointer to the top element of the stack
+ * 	returns: a pointer to the top element of the stack, valid until the next push
  */
 StackNode* top(Stack* stack);
 
@@ -0,0 +1,27 @@
+/*
+ * zobrist.c
+ */
+
+#include "zobrist.h"
+
+/*
+ * Function: zobrist_mix
+ * ----------------------
+ * 	The splitmix64 finalizer, maps every input to a different, well spread output.
+ */
+unsigned long zobrist_mix(unsigned long x) {
+	x += 0x9E3779B97F4A7C15UL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9UL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBUL;
+	return x ^ (x >> 31);
+}
+
+unsigned long zobrist_key(int cell, int value) {
+	return zobrist_mix(((unsigned long) cell << 8) | (unsigned long) value);
+}
+
+unsigned long zobrist_shape_key(int block_row, int block_col) {
+	/* above every (cell, value) input, so shape keys never equal cell keys */
+	return zobrist_mix((1UL << 40) | ((unsigned long) block_row << 8)
+			| (unsigned long) block_col);
+}
@@ -0,0 +1,41 @@
+/*
+ * zobrist.h
+ */
+
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+/*
+ * Zobrist hashing of board positions. Every (cell, value) pair has a random 64 bit key, and the hash
+ * of a position is the xor of the keys of its filled cells and of a key of the board's shape, so
+ * setting or clearing a single cell changes the hash by a single xor. The keys are derived from the
+ * pair with a mixing function instead of being kept in a table, which would grow like board_size^3.
+ * Hashes are unsigned longs, 64 bits on the LP64 platforms the program is built on.
+ */
+
+/*
+ * Function: zobrist_key
+ * ----------------------
+ * 	Receives a cell and a value and returns the key of the value in the cell.
+ *
+ * 	cell : the linear index of the cell.
+ * 	value : the value, between 1 and OPTIONS_MAX_VALUE.
+ *
+ * 	returns: the key of the pair.
+ */
+unsigned long zobrist_key(int cell, int value);
+
+/*
+ * Function: zobrist_shape_key
+ * ----------------------
+ * 	Receives the blocks dimensions of a board and returns the key of its shape, which is the hash of
+ * 	an empty board of that shape.
+ *
+ * 	block_row : an integer representing how many rows every block have.
+ * 	block_col : an integer representing how many columns every block have.
+ *
+ * 	returns: the key of the shape.
+ */
+unsigned long zobrist_shape_key(int block_row, int block_col);
+
+#endif /* ZOBRIST_H_ */